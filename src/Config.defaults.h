@@ -185,6 +185,63 @@
 #ifndef STEP_WAVE_FORM
 #define STEP_WAVE_FORM                PULSE
 #endif
+#ifndef STEP_DIR_MICROSTEP_LEVELS
+#define STEP_DIR_MICROSTEP_LEVELS     OFF                         // ON picks intermediate slewing microstep resolutions by speed (TMC drivers)
+#endif
+#ifndef STEP_DIR_MICROSTEP_LEVEL_RATE
+#define STEP_DIR_MICROSTEP_LEVEL_RATE 10000                       // step rate in Hz above which the next coarser microstep resolution is used
+#endif
+#ifndef STEP_DIR_PROFILER
+#define STEP_DIR_PROFILER             OFF                         // ON records step ISR cost and step timing for :GXP[n]# and :GXJ[n]#
+#endif
+#ifndef STEP_DIR_SCHEDULER
+#define STEP_DIR_SCHEDULER            OFF                         // ON steps all step/dir axes from one hardware timer
+#endif
+#ifndef STEP_DIR_SCHEDULER_RATE
+#define STEP_DIR_SCHEDULER_RATE       40000                       // step scheduler tick rate in Hz, the highest step rate (half that for SQUARE)
+#endif
+#ifndef STEP_DIR_RAMP
+#define STEP_DIR_RAMP                 OFF                         // ON spreads axis rate changes over each axis poll, needs STEP_DIR_SCHEDULER ON
+#endif
+#ifndef BACKLASH_TAKEUP_RAMP
+#define BACKLASH_TAKEUP_RAMP          OFF                         // in ms, OFF or time to ramp from the current rate to the backlash takeup rate
+#endif
+#ifndef MOTION_GROUP
+#define MOTION_GROUP                  OFF                         // ON polls the mount axes together, rate changes swap in on one scheduler tick
+#endif
+#ifndef SERVO_LOOP_RATE
+#define SERVO_LOOP_RATE               OFF                         // OFF or 1000 to 4000 (Hz) runs the axis1/2 servo control loop from a hardware timer
+#endif
+#ifndef SERVO_AUTOTUNE
+#define SERVO_AUTOTUNE                OFF                         // ON enables the :SXT[n],[d]# servo relay auto-tune command
+#endif
+#ifndef SERVO_PROFILER
+#define SERVO_PROFILER                OFF                         // ON records servo control loop cost and tracking error for :GXP[n]# and :GXM[n]#
+#endif
+#ifndef ENCODER_CORRECTION
+#define ENCODER_CORRECTION            OFF                         // ON corrects absolute encoder error measured by the :SXC[n],[d]# calibration sweep
+#endif
+#ifndef SERVO_SIM_TIME_CONSTANT
+#define SERVO_SIM_TIME_CONSTANT       40                          // SERVO_SIM plant mechanical time constant (inertia), in ms
+#endif
+#ifndef SERVO_SIM_FRICTION
+#define SERVO_SIM_FRICTION            5                           // SERVO_SIM plant running (Coulomb) friction, in % of full power
+#endif
+#ifndef SERVO_SIM_STICTION
+#define SERVO_SIM_STICTION            8                           // SERVO_SIM plant breakaway friction, in % of full power
+#endif
+#ifndef SERVO_SIM_BACKLASH
+#define SERVO_SIM_BACKLASH            20                          // SERVO_SIM plant gear train backlash, in encoder counts
+#endif
+#ifndef SERVO_SIM_PE_AMPLITUDE
+#define SERVO_SIM_PE_AMPLITUDE        0                           // SERVO_SIM plant gear periodic error, in encoder counts (0 for none)
+#endif
+#ifndef SERVO_SIM_PE_PERIOD
+#define SERVO_SIM_PE_PERIOD           100000                      // SERVO_SIM plant gear periodic error period, in encoder counts of axis travel
+#endif
+#ifndef SERVO_SIM_QUANTIZE
+#define SERVO_SIM_QUANTIZE            1                           // SERVO_SIM encoder resolution, in encoder counts per reported step
+#endif
 
 #if AXIS1_STEP_STATE == AXIS2_STEP_STATE == AXIS3_STEP_STATE == \
     AXIS4_STEP_STATE == AXIS5_STEP_STATE == AXIS6_STEP_STATE == \
@@ -337,7 +394,7 @@
   #endif                                                          // approximate, for DC motors only
 
   #ifndef AXIS1_SERVO_FEEDBACK
-  #define AXIS1_SERVO_FEEDBACK          DUAL_PID                  // type of feedback: DUAL_PID
+  #define AXIS1_SERVO_FEEDBACK          DUAL_PID                  // type of feedback: DUAL_PID, CASCADE
   #endif
   #ifndef AXIS1_PID_SENSITIVITY
   #define AXIS1_PID_SENSITIVITY         0                         // 0 to use slewing state, or % power for 100% pid set two (_GOTO)
@@ -360,10 +417,34 @@
   #ifndef AXIS1_PID_D_GOTO
   #define AXIS1_PID_D_GOTO              AXIS1_PID_D               // D = derivative
   #endif
+  #ifndef AXIS1_CASCADE_POS_P
+  #define AXIS1_CASCADE_POS_P           0.0                       // CASCADE position loop gain, in 1/s
+  #endif
+  #ifndef AXIS1_CASCADE_VEL_P
+  #define AXIS1_CASCADE_VEL_P           0.0                       // CASCADE velocity loop proportional gain
+  #endif
+  #ifndef AXIS1_CASCADE_VEL_I
+  #define AXIS1_CASCADE_VEL_I           0.0                       // CASCADE velocity loop integral gain, in 1/s
+  #endif
+  #ifndef AXIS1_CASCADE_VEL_FF
+  #define AXIS1_CASCADE_VEL_FF          1.0                       // CASCADE commanded velocity feed-forward, 1.0 for all
+  #endif
+  #ifndef AXIS1_CASCADE_ACCEL_FF
+  #define AXIS1_CASCADE_ACCEL_FF        0.0                       // CASCADE commanded acceleration feed-forward, in seconds
+  #endif
 
   #ifndef AXIS1_SERVO_FLTR
   #define AXIS1_SERVO_FLTR              OFF                       // servo encoder filter: OFF
   #endif
+  #ifndef AXIS1_SERVO_FLTR_PERIOD1
+  #define AXIS1_SERVO_FLTR_PERIOD1      0                         // LEARNING first known period (worm, etc.), in encoder counts
+  #endif
+  #ifndef AXIS1_SERVO_FLTR_PERIOD2
+  #define AXIS1_SERVO_FLTR_PERIOD2      0                         // LEARNING second known period, in encoder counts or 0 if unused
+  #endif
+  #ifndef AXIS1_SERVO_FLTR_PERIOD3
+  #define AXIS1_SERVO_FLTR_PERIOD3      0                         // LEARNING third known period, in encoder counts or 0 if unused
+  #endif
   #ifndef AXIS1_ENCODER
   #define AXIS1_ENCODER                 AB                        // type of encoder: AB, CW_CCW, PULSE_DIR, PULSE_ONLY, SERIAL_BRIDGE
   #endif
@@ -533,10 +614,34 @@
   #ifndef AXIS2_PID_D_GOTO
   #define AXIS2_PID_D_GOTO              AXIS2_PID_D
   #endif
+  #ifndef AXIS2_CASCADE_POS_P
+  #define AXIS2_CASCADE_POS_P           0.0
+  #endif
+  #ifndef AXIS2_CASCADE_VEL_P
+  #define AXIS2_CASCADE_VEL_P           0.0
+  #endif
+  #ifndef AXIS2_CASCADE_VEL_I
+  #define AXIS2_CASCADE_VEL_I           0.0
+  #endif
+  #ifndef AXIS2_CASCADE_VEL_FF
+  #define AXIS2_CASCADE_VEL_FF          1.0
+  #endif
+  #ifndef AXIS2_CASCADE_ACCEL_FF
+  #define AXIS2_CASCADE_ACCEL_FF        0.0
+  #endif
 
   #ifndef AXIS2_SERVO_FLTR
   #define AXIS2_SERVO_FLTR              OFF
   #endif
+  #ifndef AXIS2_SERVO_FLTR_PERIOD1
+  #define AXIS2_SERVO_FLTR_PERIOD1      0
+  #endif
+  #ifndef AXIS2_SERVO_FLTR_PERIOD2
+  #define AXIS2_SERVO_FLTR_PERIOD2      0
+  #endif
+  #ifndef AXIS2_SERVO_FLTR_PERIOD3
+  #define AXIS2_SERVO_FLTR_PERIOD3      0
+  #endif
   #ifndef AXIS2_ENCODER
   #define AXIS2_ENCODER                 AB
   #endif
@@ -757,6 +862,15 @@
 #ifndef LIMIT_RECOVERY_WITH_TRACKING
 #define LIMIT_RECOVERY_WITH_TRACKING  OFF                         // ON to automatically enable tracking on limit recovery
 #endif
+#ifndef LIMIT_LOOKAHEAD
+#define LIMIT_LOOKAHEAD               OFF                         // tracking look-ahead in seconds (60 to 86400) for a time-to-limit estimate, or OFF
+#endif
+#ifndef LIMIT_KEEP_OUT
+#define LIMIT_KEEP_OUT                OFF                         // ON for pier, tripod, OTA and counterweight keep-out zones (equatorial mounts)
+#endif
+#ifndef LIMIT_HORIZON_MASK
+#define LIMIT_HORIZON_MASK            OFF                         // ON for a per-azimuth (1 degree) horizon limit stored in NV
+#endif
 
 // st4
 #ifndef ST4_INTERFACE
@@ -771,6 +885,9 @@
 #ifndef ST4_HAND_CONTROL_FOCUSER
 #define ST4_HAND_CONTROL_FOCUSER      OFF
 #endif
+#ifndef ST4_EDGE_CAPTURE
+#define ST4_EDGE_CAPTURE              OFF                         // ON timestamps ST4 edges in pin interrupts for exact guide durations
+#endif
 
 // park
 #ifndef PARK_SENSE
@@ -812,6 +929,9 @@
 #ifndef GUIDE_DISABLE_BACKLASH
 #define GUIDE_DISABLE_BACKLASH        OFF                         // disables backlash while pulse-guiding
 #endif
+#ifndef GUIDE_BACKLASH_PREDICT
+#define GUIDE_BACKLASH_PREDICT        OFF                         // ON takes up Axis2 backlash early when pulse-guides keep reversing
+#endif
 #ifndef GUIDE_SEPARATE_PULSE_RATE
 #define GUIDE_SEPARATE_PULSE_RATE     ON                          // normally always enabled
 #endif
@@ -1064,6 +1184,15 @@
   #ifndef AXIS3_SERVO_FLTR
   #define AXIS3_SERVO_FLTR              OFF
   #endif
+  #ifndef AXIS3_SERVO_FLTR_PERIOD1
+  #define AXIS3_SERVO_FLTR_PERIOD1      0
+  #endif
+  #ifndef AXIS3_SERVO_FLTR_PERIOD2
+  #define AXIS3_SERVO_FLTR_PERIOD2      0
+  #endif
+  #ifndef AXIS3_SERVO_FLTR_PERIOD3
+  #define AXIS3_SERVO_FLTR_PERIOD3      0
+  #endif
   #ifndef AXIS3_ENCODER
   #define AXIS3_ENCODER                 AB
   #endif
@@ -1251,6 +1380,15 @@
   #ifndef AXIS4_SERVO_FLTR
   #define AXIS4_SERVO_FLTR              OFF
   #endif
+  #ifndef AXIS4_SERVO_FLTR_PERIOD1
+  #define AXIS4_SERVO_FLTR_PERIOD1      0
+  #endif
+  #ifndef AXIS4_SERVO_FLTR_PERIOD2
+  #define AXIS4_SERVO_FLTR_PERIOD2      0
+  #endif
+  #ifndef AXIS4_SERVO_FLTR_PERIOD3
+  #define AXIS4_SERVO_FLTR_PERIOD3      0
+  #endif
   #ifndef AXIS4_ENCODER
   #define AXIS4_ENCODER                 AB
   #endif
@@ -1424,6 +1562,15 @@
   #ifndef AXIS5_SERVO_FLTR
   #define AXIS5_SERVO_FLTR              OFF
   #endif
+  #ifndef AXIS5_SERVO_FLTR_PERIOD1
+  #define AXIS5_SERVO_FLTR_PERIOD1      0
+  #endif
+  #ifndef AXIS5_SERVO_FLTR_PERIOD2
+  #define AXIS5_SERVO_FLTR_PERIOD2      0
+  #endif
+  #ifndef AXIS5_SERVO_FLTR_PERIOD3
+  #define AXIS5_SERVO_FLTR_PERIOD3      0
+  #endif
   #ifndef AXIS5_ENCODER
   #define AXIS5_ENCODER                 AB
   #endif
@@ -1588,6 +1735,15 @@
   #ifndef AXIS6_SERVO_FLTR
   #define AXIS6_SERVO_FLTR              OFF
   #endif
+  #ifndef AXIS6_SERVO_FLTR_PERIOD1
+  #define AXIS6_SERVO_FLTR_PERIOD1      0
+  #endif
+  #ifndef AXIS6_SERVO_FLTR_PERIOD2
+  #define AXIS6_SERVO_FLTR_PERIOD2      0
+  #endif
+  #ifndef AXIS6_SERVO_FLTR_PERIOD3
+  #define AXIS6_SERVO_FLTR_PERIOD3      0
+  #endif
   #ifndef AXIS6_ENCODER
   #define AXIS6_ENCODER                 AB
   #endif
@@ -1751,6 +1907,15 @@
   #ifndef AXIS7_SERVO_FLTR
   #define AXIS7_SERVO_FLTR              OFF
   #endif
+  #ifndef AXIS7_SERVO_FLTR_PERIOD1
+  #define AXIS7_SERVO_FLTR_PERIOD1      0
+  #endif
+  #ifndef AXIS7_SERVO_FLTR_PERIOD2
+  #define AXIS7_SERVO_FLTR_PERIOD2      0
+  #endif
+  #ifndef AXIS7_SERVO_FLTR_PERIOD3
+  #define AXIS7_SERVO_FLTR_PERIOD3      0
+  #endif
   #ifndef AXIS7_ENCODER
   #define AXIS7_ENCODER                 AB
   #endif
@@ -1915,6 +2080,15 @@
   #ifndef AXIS8_SERVO_FLTR
   #define AXIS8_SERVO_FLTR              OFF
   #endif
+  #ifndef AXIS8_SERVO_FLTR_PERIOD1
+  #define AXIS8_SERVO_FLTR_PERIOD1      0
+  #endif
+  #ifndef AXIS8_SERVO_FLTR_PERIOD2
+  #define AXIS8_SERVO_FLTR_PERIOD2      0
+  #endif
+  #ifndef AXIS8_SERVO_FLTR_PERIOD3
+  #define AXIS8_SERVO_FLTR_PERIOD3      0
+  #endif
   #ifndef AXIS8_ENCODER
   #define AXIS8_ENCODER                 AB
   #endif
@@ -2079,6 +2253,15 @@
   #ifndef AXIS9_SERVO_FLTR
   #define AXIS9_SERVO_FLTR              OFF
   #endif
+  #ifndef AXIS9_SERVO_FLTR_PERIOD1
+  #define AXIS9_SERVO_FLTR_PERIOD1      0
+  #endif
+  #ifndef AXIS9_SERVO_FLTR_PERIOD2
+  #define AXIS9_SERVO_FLTR_PERIOD2      0
+  #endif
+  #ifndef AXIS9_SERVO_FLTR_PERIOD3
+  #define AXIS9_SERVO_FLTR_PERIOD3      0
+  #endif
   #ifndef AXIS9_ENCODER
   #define AXIS9_ENCODER                 AB
   #endif
@@ -2185,10 +2368,13 @@
 #if DRIVER_CHECK(SERVO_KTECH)
   #define SERVO_KTECH_PRESENT
 #endif
+#if DRIVER_CHECK(SERVO_SIM)
+  #define SERVO_SIM_PRESENT
+#endif
 
 #if defined(SERVO_PE_PRESENT) || defined(SERVO_EE_PRESENT) || defined(SERVO_TMC2130_DC_PRESENT) || \
     defined(SERVO_TMC5160_DC_PRESENT) || defined(SERVO_TMC2209_PRESENT) || defined(SERVO_TMC5160_PRESENT) || \
-    defined(SERVO_KTECH_PRESENT)
+    defined(SERVO_KTECH_PRESENT) || defined(SERVO_SIM_PRESENT)
   #define SERVO_MOTOR_PRESENT
 #endif
 
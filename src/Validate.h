@@ -101,6 +101,86 @@
   #error "Configuration (Config.h): Setting STEP_WAVE_FORM SQUARE is required for the Teensy4.0 and 4.1"
 #endif
 
+#if STEP_DIR_MICROSTEP_LEVELS != ON && STEP_DIR_MICROSTEP_LEVELS != OFF
+  #error "Configuration (Config.h): Setting STEP_DIR_MICROSTEP_LEVELS unknown, use OFF or ON."
+#endif
+
+#if STEP_DIR_MICROSTEP_LEVEL_RATE < 1000 || STEP_DIR_MICROSTEP_LEVEL_RATE > 200000
+  #error "Configuration (Config.h): Setting STEP_DIR_MICROSTEP_LEVEL_RATE unknown, use 1000 to 200000 (Hz.)"
+#endif
+
+#if STEP_DIR_PROFILER != ON && STEP_DIR_PROFILER != OFF
+  #error "Configuration (Config.h): Setting STEP_DIR_PROFILER unknown, use OFF or ON."
+#endif
+
+#if STEP_DIR_SCHEDULER != ON && STEP_DIR_SCHEDULER != OFF
+  #error "Configuration (Config.h): Setting STEP_DIR_SCHEDULER unknown, use OFF or ON."
+#endif
+
+#if STEP_DIR_SCHEDULER_RATE < 5000 || STEP_DIR_SCHEDULER_RATE > 200000
+  #error "Configuration (Config.h): Setting STEP_DIR_SCHEDULER_RATE unknown, use 5000 to 200000 (Hz.)"
+#endif
+
+#if STEP_DIR_RAMP != ON && STEP_DIR_RAMP != OFF
+  #error "Configuration (Config.h): Setting STEP_DIR_RAMP unknown, use OFF or ON."
+#endif
+
+#if STEP_DIR_RAMP == ON && STEP_DIR_SCHEDULER != ON
+  #error "Configuration (Config.h): Setting STEP_DIR_RAMP ON requires STEP_DIR_SCHEDULER ON."
+#endif
+
+#if BACKLASH_TAKEUP_RAMP != OFF && (BACKLASH_TAKEUP_RAMP < 10 || BACKLASH_TAKEUP_RAMP > 2000)
+  #error "Configuration (Config.h): Setting BACKLASH_TAKEUP_RAMP unknown, use OFF or 10 to 2000 (ms.)"
+#endif
+
+#if MOTION_GROUP != ON && MOTION_GROUP != OFF
+  #error "Configuration (Config.h): Setting MOTION_GROUP unknown, use OFF or ON."
+#endif
+
+#if SERVO_LOOP_RATE != OFF && (SERVO_LOOP_RATE < 1000 || SERVO_LOOP_RATE > 4000)
+  #error "Configuration (Config.h): Setting SERVO_LOOP_RATE unknown, use OFF or 1000 to 4000 (Hz.)"
+#endif
+
+#if SERVO_AUTOTUNE != ON && SERVO_AUTOTUNE != OFF
+  #error "Configuration (Config.h): Setting SERVO_AUTOTUNE unknown, use OFF or ON."
+#endif
+
+#if SERVO_PROFILER != ON && SERVO_PROFILER != OFF
+  #error "Configuration (Config.h): Setting SERVO_PROFILER unknown, use OFF or ON."
+#endif
+
+#if ENCODER_CORRECTION != ON && ENCODER_CORRECTION != OFF
+  #error "Configuration (Config.h): Setting ENCODER_CORRECTION unknown, use OFF or ON."
+#endif
+
+#if SERVO_SIM_TIME_CONSTANT < 1 || SERVO_SIM_TIME_CONSTANT > 10000
+  #error "Configuration (Config.h): Setting SERVO_SIM_TIME_CONSTANT unknown, use 1 to 10000 (ms.)"
+#endif
+
+#if SERVO_SIM_FRICTION < 0 || SERVO_SIM_FRICTION > 50
+  #error "Configuration (Config.h): Setting SERVO_SIM_FRICTION unknown, use 0 to 50 (%.)"
+#endif
+
+#if SERVO_SIM_STICTION < SERVO_SIM_FRICTION || SERVO_SIM_STICTION > 50
+  #error "Configuration (Config.h): Setting SERVO_SIM_STICTION unknown, use SERVO_SIM_FRICTION to 50 (%.)"
+#endif
+
+#if SERVO_SIM_BACKLASH < 0 || SERVO_SIM_BACKLASH > 100000
+  #error "Configuration (Config.h): Setting SERVO_SIM_BACKLASH unknown, use 0 to 100000 (counts.)"
+#endif
+
+#if SERVO_SIM_PE_AMPLITUDE < 0 || SERVO_SIM_PE_AMPLITUDE > 100000
+  #error "Configuration (Config.h): Setting SERVO_SIM_PE_AMPLITUDE unknown, use 0 to 100000 (counts.)"
+#endif
+
+#if SERVO_SIM_PE_PERIOD < 100
+  #error "Configuration (Config.h): Setting SERVO_SIM_PE_PERIOD unknown, use a value >= 100 (counts.)"
+#endif
+
+#if SERVO_SIM_QUANTIZE < 1 || SERVO_SIM_QUANTIZE > 1000
+  #error "Configuration (Config.h): Setting SERVO_SIM_QUANTIZE unknown, use 1 to 1000 (counts.)"
+#endif
+
 // MOUNT -----------------------------------------
 
 #if (AXIS1_DRIVER_MODEL != OFF && AXIS2_DRIVER_MODEL == OFF) || \
@@ -161,9 +241,28 @@
   #if AXIS1_ENCODER < ENC_FIRST || AXIS1_ENCODER > ENC_LAST
     #error "Configuration (Config.h): Setting AXIS1_ENCODER unknown, use a valid SERVO ENCODER (from Constants.h)"
   #endif
+  #if AXIS1_SERVO_FLTR == LEARNING
+    static_assert(AXIS1_SERVO_FLTR_PERIOD1 >= 64,
+      "Configuration (Config.h): Setting AXIS1_SERVO_FLTR_PERIOD1 is required for LEARNING, use a period of at least 64 (encoder counts.)");
+    static_assert((AXIS1_SERVO_FLTR_PERIOD2 == 0 || AXIS1_SERVO_FLTR_PERIOD2 >= 64) && (AXIS1_SERVO_FLTR_PERIOD3 == 0 || AXIS1_SERVO_FLTR_PERIOD3 >= 64),
+      "Configuration (Config.h): Settings AXIS1_SERVO_FLTR_PERIOD2 and AXIS1_SERVO_FLTR_PERIOD3 unknown, use 0 or a period of at least 64 (encoder counts.)");
+  #endif
   #if AXIS1_DRIVER_IGOTO != OFF
     #error "Configuration (Config.h): Setting AXIS1_DRIVER_IGOTO must be OFF for servo mode."
   #endif
+  #if AXIS1_SERVO_FEEDBACK < SERVO_FEEDBACK_FIRST || AXIS1_SERVO_FEEDBACK > SERVO_FEEDBACK_LAST
+    #error "Configuration (Config.h): Setting AXIS1_SERVO_FEEDBACK unknown, use a valid SERVO FEEDBACK (from Constants.h)"
+  #endif
+  #if SERVO_LOOP_RATE != OFF && AXIS1_SERVO_FEEDBACK == PID
+    #error "Configuration (Config.h): Setting AXIS1_SERVO_FEEDBACK PID doesn't support SERVO_LOOP_RATE, use DUAL_PID or CASCADE."
+  #endif
+  #if AXIS1_SERVO_FEEDBACK == CASCADE
+    static_assert(AXIS1_CASCADE_POS_P > 0 && AXIS1_CASCADE_VEL_P > 0 && AXIS1_CASCADE_VEL_I > 0,
+      "Configuration (Config.h): Settings AXIS1_CASCADE_POS_P, AXIS1_CASCADE_VEL_P, and AXIS1_CASCADE_VEL_I must be above 0 for CASCADE.");
+  #endif
+  #if (AXIS1_DRIVER_MODEL == SERVO_SIM) != (AXIS1_ENCODER == SIMULATED)
+    #error "Configuration (Config.h): Settings AXIS1_DRIVER_MODEL SERVO_SIM and AXIS1_ENCODER SIMULATED must be used together."
+  #endif
   #if (AXIS1_DRIVER_MODEL == SERVO_TMC2209 || AXIS1_DRIVER_MODEL == SERVO_TMC5160) && \
       (AXIS1_DRIVER_MICROSTEPS != 256 || AXIS1_DRIVER_MICROSTEPS_GOTO != OFF)
     #error "Configuration (Config.h): Settings AXIS1_DRIVER_MICROSTEPS must be 256 and AXIS1_DRIVER_MICROSTEPS_GOTO must be OFF for SERVO_TMC2209/SERVO_TMC5160."
@@ -269,9 +368,28 @@
   #if AXIS2_ENCODER < ENC_FIRST || AXIS2_ENCODER > ENC_LAST
     #error "Configuration (Config.h): Setting AXIS2_ENCODER unknown, use a valid SERVO ENCODER (from Constants.h)"
   #endif
+  #if AXIS2_SERVO_FLTR == LEARNING
+    static_assert(AXIS2_SERVO_FLTR_PERIOD1 >= 64,
+      "Configuration (Config.h): Setting AXIS2_SERVO_FLTR_PERIOD1 is required for LEARNING, use a period of at least 64 (encoder counts.)");
+    static_assert((AXIS2_SERVO_FLTR_PERIOD2 == 0 || AXIS2_SERVO_FLTR_PERIOD2 >= 64) && (AXIS2_SERVO_FLTR_PERIOD3 == 0 || AXIS2_SERVO_FLTR_PERIOD3 >= 64),
+      "Configuration (Config.h): Settings AXIS2_SERVO_FLTR_PERIOD2 and AXIS2_SERVO_FLTR_PERIOD3 unknown, use 0 or a period of at least 64 (encoder counts.)");
+  #endif
   #if AXIS2_DRIVER_IGOTO != OFF
     #error "Configuration (Config.h): Setting AXIS2_DRIVER_IGOTO must be OFF for servo mode."
   #endif
+  #if AXIS2_SERVO_FEEDBACK < SERVO_FEEDBACK_FIRST || AXIS2_SERVO_FEEDBACK > SERVO_FEEDBACK_LAST
+    #error "Configuration (Config.h): Setting AXIS2_SERVO_FEEDBACK unknown, use a valid SERVO FEEDBACK (from Constants.h)"
+  #endif
+  #if SERVO_LOOP_RATE != OFF && AXIS2_SERVO_FEEDBACK == PID
+    #error "Configuration (Config.h): Setting AXIS2_SERVO_FEEDBACK PID doesn't support SERVO_LOOP_RATE, use DUAL_PID or CASCADE."
+  #endif
+  #if AXIS2_SERVO_FEEDBACK == CASCADE
+    static_assert(AXIS2_CASCADE_POS_P > 0 && AXIS2_CASCADE_VEL_P > 0 && AXIS2_CASCADE_VEL_I > 0,
+      "Configuration (Config.h): Settings AXIS2_CASCADE_POS_P, AXIS2_CASCADE_VEL_P, and AXIS2_CASCADE_VEL_I must be above 0 for CASCADE.");
+  #endif
+  #if (AXIS2_DRIVER_MODEL == SERVO_SIM) != (AXIS2_ENCODER == SIMULATED)
+    #error "Configuration (Config.h): Settings AXIS2_DRIVER_MODEL SERVO_SIM and AXIS2_ENCODER SIMULATED must be used together."
+  #endif
   #if (AXIS2_DRIVER_MODEL == SERVO_TMC2209 || AXIS2_DRIVER_MODEL == SERVO_TMC5160) && \
       (AXIS2_DRIVER_MICROSTEPS != 256 || AXIS2_DRIVER_MICROSTEPS_GOTO != OFF)
     #error "Configuration (Config.h): Settings AXIS2_DRIVER_MICROSTEPS must be 256 and AXIS2_DRIVER_MICROSTEPS_GOTO must be OFF for SERVO_TMC2209/SERVO_TMC5160."
@@ -433,6 +551,14 @@
   #error "Configuration (Config.h): Setting ST4_HAND_CONTROL_FOCUSER unknown, use OFF or ON."
 #endif
 
+#if ST4_EDGE_CAPTURE != ON && ST4_EDGE_CAPTURE != OFF
+  #error "Configuration (Config.h): Setting ST4_EDGE_CAPTURE unknown, use OFF or ON."
+#endif
+
+#if ST4_EDGE_CAPTURE == ON && ST4_HAND_CONTROL == ON
+  #error "Configuration (Config.h): Setting ST4_EDGE_CAPTURE requires ST4_HAND_CONTROL OFF."
+#endif
+
 // GUIDING
 #if GUIDE_TIME_LIMIT < 0 || GUIDE_TIME_LIMIT > 120
   #error "Configuration (Config.h): Setting GUIDE_TIME_LIMIT unknown, use the value 0 to disable or 1 to 120 (seconds.)"
@@ -442,6 +568,14 @@
   #error "Configuration (Config.h): Setting GUIDE_DISABLE_BACKLASH unknown, use OFF or ON."
 #endif
 
+#if GUIDE_BACKLASH_PREDICT != ON && GUIDE_BACKLASH_PREDICT != OFF
+  #error "Configuration (Config.h): Setting GUIDE_BACKLASH_PREDICT unknown, use OFF or ON."
+#endif
+
+#if GUIDE_BACKLASH_PREDICT == ON && GUIDE_DISABLE_BACKLASH == ON
+  #error "Configuration (Config.h): Setting GUIDE_BACKLASH_PREDICT requires GUIDE_DISABLE_BACKLASH OFF."
+#endif
+
 #if GUIDE_SEPARATE_PULSE_RATE != ON && GUIDE_SEPARATE_PULSE_RATE != OFF
   #error "Configuration (Config.h): Setting GUIDE_SEPARATE_PULSE_RATE unknown, use OFF or ON."
 #endif
@@ -451,6 +585,18 @@
   #error "Configuration (Config.h): Setting LIMIT_SENSE unknown, use OFF or HIGH/LOW and HYST() and/or THLD() as described in comments."
 #endif
 
+#if LIMIT_LOOKAHEAD != OFF && (LIMIT_LOOKAHEAD < 60 || LIMIT_LOOKAHEAD > 86400)
+  #error "Configuration (Config.h): Setting LIMIT_LOOKAHEAD unknown, use OFF or 60 to 86400 (seconds.)"
+#endif
+
+#if LIMIT_KEEP_OUT != ON && LIMIT_KEEP_OUT != OFF
+  #error "Configuration (Config.h): Setting LIMIT_KEEP_OUT unknown, use OFF or ON."
+#endif
+
+#if LIMIT_HORIZON_MASK != ON && LIMIT_HORIZON_MASK != OFF
+  #error "Configuration (Config.h): Setting LIMIT_HORIZON_MASK unknown, use OFF or ON."
+#endif
+
 // PEC (max steps per degree 360000 * 360 degrees)
 #if PEC_STEPS_PER_WORM_ROTATION < 0 || PEC_STEPS_PER_WORM_ROTATION > 129600000
   #error "Configuration (Config.h): Setting PEC_STEPS_PER_WORM_ROTATION unknown, use the value 0 to disable or 1 to 129600000 (steps.)"
@@ -642,9 +788,21 @@ static_assert(AXIS2_LIMIT_SYNC == OFF || (AXIS2_LIMIT_SYNC >= 0 && AXIS2_LIMIT_S
   #if AXIS3_ENCODER != OFF && (AXIS3_ENCODER < ENC_FIRST || AXIS3_ENCODER > ENC_LAST)
     #error "Configuration (Config.h): Setting AXIS3_ENCODER unknown, use a valid SERVO ENCODER (from Constants.h)"
   #endif
+  #if AXIS3_SERVO_FLTR == LEARNING
+    static_assert(AXIS3_SERVO_FLTR_PERIOD1 >= 64,
+      "Configuration (Config.h): Setting AXIS3_SERVO_FLTR_PERIOD1 is required for LEARNING, use a period of at least 64 (encoder counts.)");
+    static_assert((AXIS3_SERVO_FLTR_PERIOD2 == 0 || AXIS3_SERVO_FLTR_PERIOD2 >= 64) && (AXIS3_SERVO_FLTR_PERIOD3 == 0 || AXIS3_SERVO_FLTR_PERIOD3 >= 64),
+      "Configuration (Config.h): Settings AXIS3_SERVO_FLTR_PERIOD2 and AXIS3_SERVO_FLTR_PERIOD3 unknown, use 0 or a period of at least 64 (encoder counts.)");
+  #endif
   #if AXIS3_DRIVER_IGOTO != OFF
     #error "Configuration (Config.h): Setting AXIS3_DRIVER_IGOTO must be OFF for servo mode."
   #endif
+  #if AXIS3_SERVO_FEEDBACK == CASCADE
+    #error "Configuration (Config.h): Setting AXIS3_SERVO_FEEDBACK CASCADE is only supported on the mount axes."
+  #endif
+  #if AXIS3_DRIVER_MODEL == SERVO_SIM || AXIS3_ENCODER == SIMULATED
+    #error "Configuration (Config.h): Settings AXIS3_DRIVER_MODEL SERVO_SIM and AXIS3_ENCODER SIMULATED are only supported on the mount axes."
+  #endif
   #if (AXIS3_DRIVER_MODEL == SERVO_TMC2209 || AXIS3_DRIVER_MODEL == SERVO_TMC5160) && \
       (AXIS3_DRIVER_MICROSTEPS != 256 || AXIS3_DRIVER_MICROSTEPS_GOTO != OFF)
     #error "Configuration (Config.h): Settings AXIS3_DRIVER_MICROSTEPS must be 256 and AXIS3_DRIVER_MICROSTEPS_GOTO must be OFF for SERVO_TMC2209/SERVO_TMC5160."
@@ -781,9 +939,21 @@ static_assert(AXIS2_LIMIT_SYNC == OFF || (AXIS2_LIMIT_SYNC >= 0 && AXIS2_LIMIT_S
   #if AXIS4_ENCODER < ENC_FIRST || AXIS4_ENCODER > ENC_LAST
     #error "Configuration (Config.h): Setting AXIS4_ENCODER unknown, use a valid SERVO ENCODER (from Constants.h)"
   #endif
+  #if AXIS4_SERVO_FLTR == LEARNING
+    static_assert(AXIS4_SERVO_FLTR_PERIOD1 >= 64,
+      "Configuration (Config.h): Setting AXIS4_SERVO_FLTR_PERIOD1 is required for LEARNING, use a period of at least 64 (encoder counts.)");
+    static_assert((AXIS4_SERVO_FLTR_PERIOD2 == 0 || AXIS4_SERVO_FLTR_PERIOD2 >= 64) && (AXIS4_SERVO_FLTR_PERIOD3 == 0 || AXIS4_SERVO_FLTR_PERIOD3 >= 64),
+      "Configuration (Config.h): Settings AXIS4_SERVO_FLTR_PERIOD2 and AXIS4_SERVO_FLTR_PERIOD3 unknown, use 0 or a period of at least 64 (encoder counts.)");
+  #endif
   #if AXIS4_DRIVER_IGOTO != OFF
     #error "Configuration (Config.h): Setting AXIS4_DRIVER_IGOTO must be OFF for servo mode."
   #endif
+  #if AXIS4_SERVO_FEEDBACK == CASCADE
+    #error "Configuration (Config.h): Setting AXIS4_SERVO_FEEDBACK CASCADE is only supported on the mount axes."
+  #endif
+  #if AXIS4_DRIVER_MODEL == SERVO_SIM || AXIS4_ENCODER == SIMULATED
+    #error "Configuration (Config.h): Settings AXIS4_DRIVER_MODEL SERVO_SIM and AXIS4_ENCODER SIMULATED are only supported on the mount axes."
+  #endif
   #if (AXIS4_DRIVER_MODEL == SERVO_TMC2209 || AXIS4_DRIVER_MODEL == SERVO_TMC5160) && \
       (AXIS4_DRIVER_MICROSTEPS != 256 || AXIS4_DRIVER_MICROSTEPS_GOTO != OFF)
     #error "Configuration (Config.h): Settings AXIS4_DRIVER_MICROSTEPS must be 256 and AXIS4_DRIVER_MICROSTEPS_GOTO must be OFF for SERVO_TMC2209/SERVO_TMC5160."
@@ -890,9 +1060,21 @@ static_assert(AXIS2_LIMIT_SYNC == OFF || (AXIS2_LIMIT_SYNC >= 0 && AXIS2_LIMIT_S
   #if AXIS5_ENCODER < ENC_FIRST || AXIS5_ENCODER > ENC_LAST
     #error "Configuration (Config.h): Setting AXIS5_ENCODER unknown, use a valid SERVO ENCODER (from Constants.h)"
   #endif
+  #if AXIS5_SERVO_FLTR == LEARNING
+    static_assert(AXIS5_SERVO_FLTR_PERIOD1 >= 64,
+      "Configuration (Config.h): Setting AXIS5_SERVO_FLTR_PERIOD1 is required for LEARNING, use a period of at least 64 (encoder counts.)");
+    static_assert((AXIS5_SERVO_FLTR_PERIOD2 == 0 || AXIS5_SERVO_FLTR_PERIOD2 >= 64) && (AXIS5_SERVO_FLTR_PERIOD3 == 0 || AXIS5_SERVO_FLTR_PERIOD3 >= 64),
+      "Configuration (Config.h): Settings AXIS5_SERVO_FLTR_PERIOD2 and AXIS5_SERVO_FLTR_PERIOD3 unknown, use 0 or a period of at least 64 (encoder counts.)");
+  #endif
   #if AXIS5_DRIVER_IGOTO != OFF
     #error "Configuration (Config.h): Setting AXIS5_DRIVER_IGOTO must be OFF for servo mode."
   #endif
+  #if AXIS5_SERVO_FEEDBACK == CASCADE
+    #error "Configuration (Config.h): Setting AXIS5_SERVO_FEEDBACK CASCADE is only supported on the mount axes."
+  #endif
+  #if AXIS5_DRIVER_MODEL == SERVO_SIM || AXIS5_ENCODER == SIMULATED
+    #error "Configuration (Config.h): Settings AXIS5_DRIVER_MODEL SERVO_SIM and AXIS5_ENCODER SIMULATED are only supported on the mount axes."
+  #endif
   #if (AXIS5_DRIVER_MODEL == SERVO_TMC2209 || AXIS5_DRIVER_MODEL == SERVO_TMC5160) && \
       (AXIS5_DRIVER_MICROSTEPS != 256 || AXIS5_DRIVER_MICROSTEPS_GOTO != OFF)
     #error "Configuration (Config.h): Settings AXIS5_DRIVER_MICROSTEPS must be 256 and AXIS5_DRIVER_MICROSTEPS_GOTO must be OFF for SERVO_TMC2209/SERVO_TMC5160."
@@ -996,9 +1178,21 @@ static_assert(AXIS2_LIMIT_SYNC == OFF || (AXIS2_LIMIT_SYNC >= 0 && AXIS2_LIMIT_S
   #if AXIS6_ENCODER < ENC_FIRST || AXIS6_ENCODER > ENC_LAST
     #error "Configuration (Config.h): Setting AXIS6_ENCODER unknown, use a valid SERVO ENCODER (from Constants.h)"
   #endif
+  #if AXIS6_SERVO_FLTR == LEARNING
+    static_assert(AXIS6_SERVO_FLTR_PERIOD1 >= 64,
+      "Configuration (Config.h): Setting AXIS6_SERVO_FLTR_PERIOD1 is required for LEARNING, use a period of at least 64 (encoder counts.)");
+    static_assert((AXIS6_SERVO_FLTR_PERIOD2 == 0 || AXIS6_SERVO_FLTR_PERIOD2 >= 64) && (AXIS6_SERVO_FLTR_PERIOD3 == 0 || AXIS6_SERVO_FLTR_PERIOD3 >= 64),
+      "Configuration (Config.h): Settings AXIS6_SERVO_FLTR_PERIOD2 and AXIS6_SERVO_FLTR_PERIOD3 unknown, use 0 or a period of at least 64 (encoder counts.)");
+  #endif
   #if AXIS6_DRIVER_IGOTO != OFF
     #error "Configuration (Config.h): Setting AXIS6_DRIVER_IGOTO must be OFF for servo mode."
   #endif
+  #if AXIS6_SERVO_FEEDBACK == CASCADE
+    #error "Configuration (Config.h): Setting AXIS6_SERVO_FEEDBACK CASCADE is only supported on the mount axes."
+  #endif
+  #if AXIS6_DRIVER_MODEL == SERVO_SIM || AXIS6_ENCODER == SIMULATED
+    #error "Configuration (Config.h): Settings AXIS6_DRIVER_MODEL SERVO_SIM and AXIS6_ENCODER SIMULATED are only supported on the mount axes."
+  #endif
   #if (AXIS6_DRIVER_MODEL == SERVO_TMC2209 || AXIS6_DRIVER_MODEL == SERVO_TMC5160) && \
       (AXIS6_DRIVER_MICROSTEPS != 256 || AXIS6_DRIVER_MICROSTEPS_GOTO != OFF)
     #error "Configuration (Config.h): Settings AXIS6_DRIVER_MICROSTEPS must be 256 and AXIS6_DRIVER_MICROSTEPS_GOTO must be OFF for SERVO_TMC2209/SERVO_TMC5160."
@@ -1102,9 +1296,21 @@ static_assert(AXIS2_LIMIT_SYNC == OFF || (AXIS2_LIMIT_SYNC >= 0 && AXIS2_LIMIT_S
   #if AXIS7_ENCODER < ENC_FIRST || AXIS7_ENCODER > ENC_LAST
     #error "Configuration (Config.h): Setting AXIS7_ENCODER unknown, use a valid SERVO ENCODER (from Constants.h)"
   #endif
+  #if AXIS7_SERVO_FLTR == LEARNING
+    static_assert(AXIS7_SERVO_FLTR_PERIOD1 >= 64,
+      "Configuration (Config.h): Setting AXIS7_SERVO_FLTR_PERIOD1 is required for LEARNING, use a period of at least 64 (encoder counts.)");
+    static_assert((AXIS7_SERVO_FLTR_PERIOD2 == 0 || AXIS7_SERVO_FLTR_PERIOD2 >= 64) && (AXIS7_SERVO_FLTR_PERIOD3 == 0 || AXIS7_SERVO_FLTR_PERIOD3 >= 64),
+      "Configuration (Config.h): Settings AXIS7_SERVO_FLTR_PERIOD2 and AXIS7_SERVO_FLTR_PERIOD3 unknown, use 0 or a period of at least 64 (encoder counts.)");
+  #endif
   #if AXIS7_DRIVER_IGOTO != OFF
     #error "Configuration (Config.h): Setting AXIS7_DRIVER_IGOTO must be OFF for servo mode."
   #endif
+  #if AXIS7_SERVO_FEEDBACK == CASCADE
+    #error "Configuration (Config.h): Setting AXIS7_SERVO_FEEDBACK CASCADE is only supported on the mount axes."
+  #endif
+  #if AXIS7_DRIVER_MODEL == SERVO_SIM || AXIS7_ENCODER == SIMULATED
+    #error "Configuration (Config.h): Settings AXIS7_DRIVER_MODEL SERVO_SIM and AXIS7_ENCODER SIMULATED are only supported on the mount axes."
+  #endif
   #if (AXIS7_DRIVER_MODEL == SERVO_TMC2209 || AXIS7_DRIVER_MODEL == SERVO_TMC5160) && \
       (AXIS7_DRIVER_MICROSTEPS != 256 || AXIS7_DRIVER_MICROSTEPS_GOTO != OFF)
     #error "Configuration (Config.h): Settings AXIS7_DRIVER_MICROSTEPS must be 256 and AXIS7_DRIVER_MICROSTEPS_GOTO must be OFF for SERVO_TMC2209/SERVO_TMC5160."
@@ -1208,9 +1414,21 @@ static_assert(AXIS2_LIMIT_SYNC == OFF || (AXIS2_LIMIT_SYNC >= 0 && AXIS2_LIMIT_S
   #if AXIS8_ENCODER < ENC_FIRST || AXIS8_ENCODER > ENC_LAST
     #error "Configuration (Config.h): Setting AXIS8_ENCODER unknown, use a valid SERVO ENCODER (from Constants.h)"
   #endif
+  #if AXIS8_SERVO_FLTR == LEARNING
+    static_assert(AXIS8_SERVO_FLTR_PERIOD1 >= 64,
+      "Configuration (Config.h): Setting AXIS8_SERVO_FLTR_PERIOD1 is required for LEARNING, use a period of at least 64 (encoder counts.)");
+    static_assert((AXIS8_SERVO_FLTR_PERIOD2 == 0 || AXIS8_SERVO_FLTR_PERIOD2 >= 64) && (AXIS8_SERVO_FLTR_PERIOD3 == 0 || AXIS8_SERVO_FLTR_PERIOD3 >= 64),
+      "Configuration (Config.h): Settings AXIS8_SERVO_FLTR_PERIOD2 and AXIS8_SERVO_FLTR_PERIOD3 unknown, use 0 or a period of at least 64 (encoder counts.)");
+  #endif
   #if AXIS8_DRIVER_IGOTO != OFF
     #error "Configuration (Config.h): Setting AXIS8_DRIVER_IGOTO must be OFF for servo mode."
   #endif
+  #if AXIS8_SERVO_FEEDBACK == CASCADE
+    #error "Configuration (Config.h): Setting AXIS8_SERVO_FEEDBACK CASCADE is only supported on the mount axes."
+  #endif
+  #if AXIS8_DRIVER_MODEL == SERVO_SIM || AXIS8_ENCODER == SIMULATED
+    #error "Configuration (Config.h): Settings AXIS8_DRIVER_MODEL SERVO_SIM and AXIS8_ENCODER SIMULATED are only supported on the mount axes."
+  #endif
   #if (AXIS8_DRIVER_MODEL == SERVO_TMC2209 || AXIS8_DRIVER_MODEL == SERVO_TMC5160) && \
       (AXIS8_DRIVER_MICROSTEPS != 256 || AXIS8_DRIVER_MICROSTEPS_GOTO != OFF)
     #error "Configuration (Config.h): Settings AXIS8_DRIVER_MICROSTEPS must be 256 and AXIS8_DRIVER_MICROSTEPS_GOTO must be OFF for SERVO_TMC2209/SERVO_TMC5160."
@@ -1314,9 +1532,21 @@ static_assert(AXIS2_LIMIT_SYNC == OFF || (AXIS2_LIMIT_SYNC >= 0 && AXIS2_LIMIT_S
   #if AXIS9_ENCODER < ENC_FIRST || AXIS9_ENCODER > ENC_LAST
     #error "Configuration (Config.h): Setting AXIS9_ENCODER unknown, use a valid SERVO ENCODER (from Constants.h)"
   #endif
+  #if AXIS9_SERVO_FLTR == LEARNING
+    static_assert(AXIS9_SERVO_FLTR_PERIOD1 >= 64,
+      "Configuration (Config.h): Setting AXIS9_SERVO_FLTR_PERIOD1 is required for LEARNING, use a period of at least 64 (encoder counts.)");
+    static_assert((AXIS9_SERVO_FLTR_PERIOD2 == 0 || AXIS9_SERVO_FLTR_PERIOD2 >= 64) && (AXIS9_SERVO_FLTR_PERIOD3 == 0 || AXIS9_SERVO_FLTR_PERIOD3 >= 64),
+      "Configuration (Config.h): Settings AXIS9_SERVO_FLTR_PERIOD2 and AXIS9_SERVO_FLTR_PERIOD3 unknown, use 0 or a period of at least 64 (encoder counts.)");
+  #endif
   #if AXIS9_DRIVER_IGOTO != OFF
     #error "Configuration (Config.h): Setting AXIS9_DRIVER_IGOTO must be OFF for servo mode."
   #endif
+  #if AXIS9_SERVO_FEEDBACK == CASCADE
+    #error "Configuration (Config.h): Setting AXIS9_SERVO_FEEDBACK CASCADE is only supported on the mount axes."
+  #endif
+  #if AXIS9_DRIVER_MODEL == SERVO_SIM || AXIS9_ENCODER == SIMULATED
+    #error "Configuration (Config.h): Settings AXIS9_DRIVER_MODEL SERVO_SIM and AXIS9_ENCODER SIMULATED are only supported on the mount axes."
+  #endif
   #if (AXIS9_DRIVER_MODEL == SERVO_TMC2209 || AXIS9_DRIVER_MODEL == SERVO_TMC5160) && \
       (AXIS9_DRIVER_MICROSTEPS != 256 || AXIS9_DRIVER_MICROSTEPS_GOTO != OFF)
     #error "Configuration (Config.h): Settings AXIS9_DRIVER_MICROSTEPS must be 256 and AXIS9_DRIVER_MICROSTEPS_GOTO must be OFF for SERVO_TMC2209/SERVO_TMC5160."
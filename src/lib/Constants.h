@@ -85,7 +85,8 @@
 #define SERVO_TMC2209               104    // TMC2209 stepper driver using VACTUAL velocity control
 #define SERVO_TMC5160               105    // TMC5160 stepper driver using VMAX velocity control
 #define SERVO_KTECH                 106    // KTech servo motor using velocity control
-#define SERVO_DRIVER_LAST           106
+#define SERVO_SIM                   107    // simulated DC motor and gear train (no hardware, for comparing filter/feedback settings)
+#define SERVO_DRIVER_LAST           107
 
 // integrated motor drivers
 #define MOTOR_DRIVER_FIRST          200
@@ -118,21 +119,23 @@
 #define LIKA_ASC85                  10     // Lika ASC85 BISS-C interface 25bit encoder (experimental)
 #define KTECH_IME                   11     // KTech in motor encoder
 #define SERIAL_BRIDGE               12     // serial bridge to encoders
-#define ENC_LAST                    12
+#define SIMULATED                   13     // simulated encoder on the SERVO_SIM plant
+#define ENC_LAST                    13
 
 // encoder filter types
 #define ENC_FILT_FIRST              1
 #define KALMAN                      1      // more advanced, predictive
 #define ROLLING                     2      // basic, rolling average
 #define WINDOWING                   ROLLING // deprecated compatibility alias for rolling average
-#define LEARNING                    4      // learning, for RA axis only (experimental may be removed)
+#define LEARNING                    4      // learning, periodic error compensation (experimental)
 #define ENC_FILT_LAST               4
 
 // servo feedback (must match Encoder library)
 #define SERVO_FEEDBACK_FIRST        1
 #define PID                         1      // PID feedback
 #define DUAL_PID                    2      // Dual PID feedback
-#define SERVO_FEEDBACK_LAST         2
+#define CASCADE                     3      // Cascaded position/velocity feedback
+#define SERVO_FEEDBACK_LAST         3
 
 // driver (step/dir) and servo, misc.
 #define ODRIVER                     -10    // general purpose flag for a ODRIVE driver motor
@@ -89,6 +89,64 @@ bool Axis::command(char *reply, char *command, char *parameter, bool *suppressFr
       } else
     #endif
 
+    #if defined(SERVO_MOTOR_PRESENT) && SERVO_AUTOTUNE == ON
+      // :GXT[n]#   Get servo auto-Tune status for axis [n]
+      //            Returns: state (0 idle, 1 running, 2 done, 3 failed),ultimate gain,ultimate period (s)
+      if (parameter[0] == 'T' && parameter[1] >= '1' && parameter[1] <= '9' && parameter[2] == 0) {
+        if (parameter[1] - '0' != axisNumber) return false; // command wasn't processed
+        if (motor->driverType != SERVO) { *commandError = CE_CMD_UNKNOWN; return true; } // not a servo
+        ((ServoMotor*)motor)->autoTuneStatus(reply);
+        *numericReply = false;
+        return true;
+      } else
+    #endif
+
+    #if defined(SERVO_MOTOR_PRESENT) && ENCODER_CORRECTION == ON
+      // :GXC[n]#   Get servo encoder Calibration status for axis [n]
+      //            Returns: state (0 idle, 1 running, 2 done, 3 failed),peak error corrected,rms error left (in counts),correction in use (0 or 1)
+      if (parameter[0] == 'C' && parameter[1] >= '1' && parameter[1] <= '9' && parameter[2] == 0) {
+        if (parameter[1] - '0' != axisNumber) return false; // command wasn't processed
+        if (motor->driverType != SERVO) { *commandError = CE_CMD_UNKNOWN; return true; } // not a servo
+        ((ServoMotor*)motor)->encoderCalibrateStatus(reply);
+        *numericReply = false;
+        return true;
+      } else
+    #endif
+
+    #if defined(SERVO_MOTOR_PRESENT) && !defined(SERVO_SAFETY_DISABLE)
+      // :GXW[n]#     Get servo safety Watchdog trip for axis [n]
+      //              Returns: reason (0 none, 1 following error, 2 runaway, 3 stall, 4 oscillation),tier (0 none, 1 fast, 2 slow)
+      // :GXW[n],[i]# Get servo safety Watchdog record [i] (0 to 15, 0 is the latest) from before the trip for axis [n]
+      //              Returns: time (in ms),motor,encoder (in counts),velocity command,velocity (in counts/s),power (in %)
+      if (parameter[0] == 'W' && parameter[1] >= '1' && parameter[1] <= '9' && (parameter[2] == 0 || parameter[2] == ',')) {
+        if (parameter[1] - '0' != axisNumber) return false; // command wasn't processed
+        if (motor->driverType != SERVO) { *commandError = CE_CMD_UNKNOWN; return true; } // not a servo
+        if (parameter[2] == 0) ((ServoMotor*)motor)->getSafetyTrip(reply); else {
+          char* conv_end;
+          long number = strtol(&parameter[3], &conv_end, 10);
+          if (&parameter[3] == conv_end) { *commandError = CE_PARAM_FORM; return true; }
+          if (!((ServoMotor*)motor)->getSafetyRecord(number, reply, 80)) { *commandError = CE_PARAM_RANGE; return true; }
+        }
+        *numericReply = false;
+        return true;
+      } else
+    #endif
+
+    #if defined(SERVO_MOTOR_PRESENT) && SERVO_PROFILER == ON
+      // :GXM[n]#   Get servo Motion tracking error for axis [n] since the last request
+      //            Returns: samples,rms error,peak error (in counts),settles,last settling time,worst settling time (in ms)
+      // :GXM[n],F# Get servo Motion tracking error Frequency spectrum for axis [n]
+      //            Returns: bin width,peak frequency (in Hz),peak amplitude,then six octave band amplitudes (in counts)
+      if (parameter[0] == 'M' && parameter[1] >= '1' && parameter[1] <= '9' &&
+          (parameter[2] == 0 || (parameter[2] == ',' && parameter[3] == 'F' && parameter[4] == 0))) {
+        if (parameter[1] - '0' != axisNumber) return false; // command wasn't processed
+        if (motor->driverType != SERVO) { *commandError = CE_CMD_UNKNOWN; return true; } // not a servo
+        if (!((ServoMotor*)motor)->getTrackingProfile(reply, 80, parameter[2] == ',')) { *commandError = CE_0; return true; }
+        *numericReply = false;
+        return true;
+      } else
+    #endif
+
     // :GXSG[n]#   Get live StallGuard telemetry for axis [n]
     //             Returns: sg,trip,badMs,armed,latched
     if (parameter[0] == 'S' && parameter[1] == 'G' && parameter[3] == 0) {
@@ -100,6 +158,28 @@ bool Axis::command(char *reply, char *command, char *parameter, bool *suppressFr
       return true;
     } else
 
+    // :GXP[n]#   Get step ISR Profile for axis [n], cost in fast ticks since the last request
+    //            Returns: min,avg,max for each of move, moveFF, moveFR, and moveT
+    if (parameter[0] == 'P' && parameter[2] == 0) {
+      int index = parameter[1] - '1';
+      if (index < 0 || index > 8) { *commandError = CE_PARAM_RANGE; return true; }
+      if (index + 1 != axisNumber) return false; // command wasn't processed
+      if (!motor->getIsrProfile(reply, 80)) { *commandError = CE_0; return true; }
+      *numericReply = false;
+      return true;
+    } else
+
+    // :GXJ[n]#   Get step timing (Jitter) for axis [n] since the last request
+    //            Returns: steps,avg jitter,max jitter (in fast ticks),max position error (in steps),calls behind target
+    if (parameter[0] == 'J' && parameter[2] == 0) {
+      int index = parameter[1] - '1';
+      if (index < 0 || index > 8) { *commandError = CE_PARAM_RANGE; return true; }
+      if (index + 1 != axisNumber) return false; // command wasn't processed
+      if (!motor->getStepTiming(reply, 80)) { *commandError = CE_0; return true; }
+      *numericReply = false;
+      return true;
+    } else
+
     // :GXU[n]#   Get stepper driver statUs for axis [n]
     //            Returns: Value
     if (parameter[0] == 'U' && parameter[2] == 0) {
@@ -182,13 +262,8 @@ bool Axis::command(char *reply, char *command, char *parameter, bool *suppressFr
         getParameter(parameterNumber)->valueNv = value;
         if (parameterNumber == 1) stepsPerMeasureValueNv = value;
 
-        // get ready to write to NV
-        AxisStoredSettings nvAxisSettings;
-        nvAxisSettings.stepsPerMeasure = stepsPerMeasureValueNv;
-        for (int i = 1; i <= getParameterCount(); i++) nvAxisSettings.value[i - 1] = getParameter(i)->valueNv;
-
         // write the settings to NV
-        nv().kv().put(nvKey, nvAxisSettings);
+        writeParameters();
 
         // update immediate parameters now
         AxisParameterType type = getParameter(parameterNumber)->type;
@@ -197,7 +272,50 @@ bool Axis::command(char *reply, char *command, char *parameter, bool *suppressFr
         }
 
       } else *commandError = CE_PARAM_RANGE;
-    } else return false;
+    } else
+
+    #if defined(SERVO_MOTOR_PRESENT) && SERVO_AUTOTUNE == ON
+      // :SXT[n],[d]#  Start servo auto-Tune for axis [n], a relay test at [d] % (1 to 25) of the maximum velocity
+      //               the axis must be enabled and stopped, the tuned gains are saved to NV when done
+      //               Return: 0 failure, 1 success
+      if (parameter[0] == 'T' && parameter[1] >= '1' && parameter[1] <= '9' && parameter[2] == ',') {
+        if (parameter[1] - '0' != axisNumber) return false; // command wasn't processed
+        if (motor->driverType != SERVO) { *commandError = CE_CMD_UNKNOWN; return true; } // not a servo
+        char* conv_end;
+        float percent = strtof(&parameter[3], &conv_end);
+        if (&parameter[3] == conv_end) { *commandError = CE_PARAM_FORM; return true; }
+        *commandError = ((ServoMotor*)motor)->autoTuneStart(percent);
+      } else
+    #endif
+
+    #if defined(SERVO_MOTOR_PRESENT) && ENCODER_CORRECTION == ON
+      // :SXC[n],[d]#  Start servo encoder Calibration for axis [n], a sweep of one encoder turn at [d] % (0.1 to 25, negative
+      //               reverses) of the maximum velocity, the axis must be enabled and stopped and the sweep must stay within
+      //               the limits, the correction is saved to NV
+      // :SXC[n],X#    Clear the encoder correction for axis [n]
+      //               Return: 0 failure, 1 success
+      if (parameter[0] == 'C' && parameter[1] >= '1' && parameter[1] <= '9' && parameter[2] == ',') {
+        if (parameter[1] - '0' != axisNumber) return false; // command wasn't processed
+        if (motor->driverType != SERVO) { *commandError = CE_CMD_UNKNOWN; return true; } // not a servo
+        if (parameter[3] == 'X' && parameter[4] == 0) {
+          *commandError = ((ServoMotor*)motor)->encoderCorrectionClear();
+        } else {
+          char* conv_end;
+          float percent = strtof(&parameter[3], &conv_end);
+          if (&parameter[3] == conv_end) { *commandError = CE_PARAM_FORM; return true; }
+          // room to the limits, in steps
+          long roomForward = INT32_MAX, roomReverse = INT32_MAX;
+          if (limitsCheck) {
+            const double position = getInstrumentCoordinate();
+            roomForward = lround((maxMeasure->value - position)*stepsPerMeasureValue);
+            roomReverse = lround((position - minMeasure->value)*stepsPerMeasureValue);
+          }
+          *commandError = ((ServoMotor*)motor)->encoderCalibrateStart(percent, roomForward, roomReverse);
+        }
+      } else
+    #endif
+
+    return false;
   } else return false;
 
   return true;
@@ -187,7 +187,6 @@ bool Axis::init(Motor *motor) {
 
   // start monitor
   VF("MSG:"); V(axisPrefix); VF("start motion controller task (rate "); V(FRACTIONAL_SEC_US); VF("us priority 1)... ");
-  uint8_t taskHandle = 0;
   char taskName[] = "Ax_Motn";
   taskName[2] = axisNumber + '0';
   taskHandle = tasks.add(0, 0, true, 1, callback, taskName);
@@ -229,8 +228,10 @@ void Axis::setPowerDownOverrideTime(int time) {
   }
 }
 
-void Axis::setBacklash(float value) {
-  if (autoRate == AR_NONE) motor->setBacklashSteps(round(value*stepsPerMeasureValue));
+void Axis::setBacklash(float value, float valueReverse) {
+  if (autoRate != AR_NONE) return;
+  long valueReverseSteps = valueReverse < 0.0F ? -1 : round(valueReverse*stepsPerMeasureValue);
+  motor->setBacklashSteps(round(value*stepsPerMeasureValue), valueReverseSteps);
 }
 
 float Axis::getBacklash() {
@@ -472,6 +473,7 @@ CommandError Axis::autoSlewHome(unsigned long timeout) {
 }
 
 void Axis::autoSlewStop() {
+  motor->abortTests();
   if (autoRate <= AR_RATE_BY_TIME_END) return;
 
   motor->setSynchronized(true);
@@ -482,6 +484,7 @@ void Axis::autoSlewStop() {
 }
 
 void Axis::autoSlewAbort() {
+  motor->abortTests();
   if (autoRate <= AR_RATE_BY_TIME_ABORT) return;
 
   motor->setSynchronized(true);
@@ -535,7 +538,7 @@ void Axis::poll() {
       autoSlewAbort();
     }
   }
-  Y;
+  if (motor->pollYield) Y;
 
   // slewing
   if (autoRate != AR_NONE && !motor->inBacklash) {
@@ -622,13 +625,19 @@ void Axis::poll() {
     freq = 0.0F;
     if (commonMinMaxSensed || motionError(DIR_BOTH) || motorFault()) baseFreq = 0.0F;
   }
-  Y;
+  if (motor->pollYield) Y;
 
   setFrequency(freq);
 
   // keep associated motor updated
   motor->poll();
 
+  // save parameters the motor tuned itself
+  if (motor->parametersChanged) {
+    motor->parametersChanged = false;
+    writeParameters();
+  }
+
   // respond to the motor disabling itself
   if (autoRate != AR_NONE && !motor->enabled) {
     autoRate = AR_NONE;
@@ -642,6 +651,9 @@ void Axis::setFrequencyMin(float frequency) {
 }
 
 void Axis::setFrequencyMax(float frequency) {
+  // the motor may not be able to step any faster
+  float limit = motor->getFrequencyLimitSteps()/stepsPerMeasure->value;
+  if (limit > 0.0F && frequency > limit) frequency = limit;
   maxFreq = frequency;
   motor->setFrequencyMax(frequency*stepsPerMeasure->value);
 }
@@ -700,6 +712,14 @@ void Axis::setFrequency(float frequency) {
   }
 }
 
+void Axis::setMonitorTask(uint8_t handle) {
+  if (taskHandle == handle) return;
+  if (taskHandle) tasks.remove(taskHandle);
+  taskHandle = handle;
+  motor->monitorHandle = handle;
+  motor->pollYield = false;
+}
+
 float Axis::getFrequency() {
   return motor->getFrequencySteps()/stepsPerMeasureValue;
 }
@@ -762,4 +782,16 @@ bool Axis::getAxisRevert() {
   }
 }
 
+void Axis::writeParameters() {
+  // NV is ignored while reverting to defaults
+  if (revert.all || getAxisRevert()) { VF("MSG:"); V(axisPrefix); VLF("reverting, parameters not written to NV"); return; }
+
+  AxisStoredSettings nvAxisSettings;
+  nvAxisSettings.revert = false;
+  nvAxisSettings.stepsPerMeasure = stepsPerMeasureValueNv;
+  for (int i = 1; i <= getParameterCount(); i++) nvAxisSettings.value[i - 1] = getParameter(i)->valueNv;
+
+  nv().kv().put(nvKey, nvAxisSettings);
+}
+
 #endif
@@ -271,8 +271,16 @@ public:
   bool nearTarget();
 
   // sets backlash amount
-  // \param value: backlash distance in "measures" (degrees, microns, etc.)
-  void setBacklash(float value);
+  // \param value: backlash distance in "measures" (degrees, microns, etc.) taken up on reversals toward forward
+  // \param valueReverse: backlash distance taken up on reversals toward reverse, negative for the same as value
+  void setBacklash(float value, float valueReverse = -1.0F);
+
+  // request backlash takeup toward direction (1 or -1) ahead of an anticipated reversal, if supported
+  inline void setBacklashPreload(int8_t direction)
+  {
+    if (autoRate == AR_NONE)
+      motor->setBacklashPreload(direction);
+  }
 
   // sets backlash amount
   // \param value: backlash distance in steps
@@ -425,6 +433,14 @@ public:
   // monitor movement
   void poll();
 
+  // hand the motion controller task over to a motion group that polls this axis along with others,
+  // this axis' own task is removed and the motor is monitored by the group task
+  // \param handle: the motion group task handle
+  void setMonitorTask(uint8_t handle);
+
+  // axis number, from 1 to 9
+  inline uint8_t getAxisNumber() { return axisNumber; }
+
   // associated motor
   Motor *motor;
 
@@ -458,12 +474,17 @@ private:
   void setAxisRevert(bool state);
   bool getAxisRevert();
 
+  // write the axis/motor/driver parameter NV values to NV
+  void writeParameters();
+
   AxisErrors errors;
   bool lastErrorResult = false;
 
   uint8_t axisNumber = 0;
   char axisPrefix[9] = " Axis_, ";
 
+  uint8_t taskHandle = 0;
+
   char unitsStr[5] = "?";
   bool unitsRadians = false;
 
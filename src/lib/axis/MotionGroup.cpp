@@ -0,0 +1,51 @@
+// -----------------------------------------------------------------------------------
+// Axis motion group, polls several axes together so their rate changes are coherent in time
+
+#include "MotionGroup.h"
+
+#if defined(MOTOR_PRESENT) && MOTION_GROUP == ON
+
+#include "../tasks/OnTask.h"
+#include "motor/stepDir/StepDirScheduler.h"
+
+static MotionGroup *motionGroupInstance = NULL;
+IRAM_ATTR void motionGroupWrapper() { motionGroupInstance->poll(); }
+
+bool MotionGroup::add(Axis *axis) {
+  if (count >= MOTION_GROUP_AXES_MAX || axis == NULL) return false;
+  axes[count++] = axis;
+  bitSet(axisMask, axis->getAxisNumber() - 1);
+  return true;
+}
+
+bool MotionGroup::init() {
+  if (taskHandle) return true;
+  if (motionGroupInstance != NULL) { DLF("ERR: MotionGroup::init(), only one motion group is supported"); return false; }
+
+  motionGroupInstance = this;
+
+  VF("MSG: MotionGroup, start motion group task (rate "); V(FRACTIONAL_SEC_US); VF("us priority 1)... ");
+  taskHandle = tasks.add(0, 0, true, 1, motionGroupWrapper, "MotnGrp");
+  if (!taskHandle) { VLF("FAILED!"); motionGroupInstance = NULL; return false; }
+  tasks.setPeriodMicros(taskHandle, FRACTIONAL_SEC_US);
+  VLF("success");
+
+  for (int i = 0; i < count; i++) axes[i]->setMonitorTask(taskHandle);
+
+  return true;
+}
+
+// the axes don't yield while polled here, so rate changes from other tasks aren't held back
+void MotionGroup::poll() {
+  #if defined(STEP_DIR_MOTOR_PRESENT) && STEP_DIR_SCHEDULER == ON
+    stepDirScheduler.hold(axisMask);
+  #endif
+
+  for (int i = 0; i < count; i++) axes[i]->poll();
+
+  #if defined(STEP_DIR_MOTOR_PRESENT) && STEP_DIR_SCHEDULER == ON
+    stepDirScheduler.release();
+  #endif
+}
+
+#endif
@@ -0,0 +1,42 @@
+// -----------------------------------------------------------------------------------
+// Axis motion group, polls several axes together so their rate changes are coherent in time
+#pragma once
+
+#include "Axis.h"
+
+#ifdef MOTOR_PRESENT
+
+#ifndef MOTION_GROUP
+#define MOTION_GROUP OFF
+#endif
+
+#if MOTION_GROUP == ON
+
+#ifndef MOTION_GROUP_AXES_MAX
+#define MOTION_GROUP_AXES_MAX 3
+#endif
+
+// one task polls all axes in the group back to back, step/dir motors on the shared step scheduler
+// hold their new rates in a second buffer that is applied for all axes on the same tick
+class MotionGroup {
+  public:
+    // add an axis to the group, the axis must already be initialized
+    bool add(Axis *axis);
+
+    // start the group task and take over monitoring of the axes, only one group is supported
+    bool init();
+
+    // poll all axes in the group, their rate changes take effect together
+    void poll();
+
+  private:
+    Axis *axes[MOTION_GROUP_AXES_MAX];
+    uint8_t count = 0;
+    uint16_t axisMask = 0;
+
+    uint8_t taskHandle = 0;
+};
+
+#endif
+
+#endif
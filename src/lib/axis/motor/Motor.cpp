@@ -139,10 +139,13 @@ long Motor::getBacklashSteps() {
 }
 
 // set backlash amount in steps
-void Motor::setBacklashSteps(long value) {
+void Motor::setBacklashSteps(long value, long valueReverse) {
+  UNUSED(valueReverse);
   if (value < 0) value = 0;
   if (value > 65535) value = 65535;
-  ATOMIC_STORE(backlashAmountSteps, (uint16_t)value);
+  noInterrupts();
+  backlashAmountSteps = value;
+  interrupts();
 }
 
 // mark origin coordinate for autoGoto as current location
@@ -181,6 +184,26 @@ void Motor::setBacklashFrequencySteps(float frequency) {
   backlashFrequency = frequency;
 }
 
+// get the frequency to use for the requested frequency (in steps per second), while in backlash
+// this is the backlash frequency ramped from the rate takeup started at over BACKLASH_TAKEUP_RAMP ms
+float Motor::getBacklashTakeUpFrequency(float frequency) {
+  #if BACKLASH_TAKEUP_RAMP != OFF
+    if (!inBacklash) { backlashTakeUp = false; return frequency; }
+
+    if (!backlashTakeUp) {
+      backlashTakeUp = true;
+      backlashTakeUpStartMs = millis();
+      backlashTakeUpStartFrequency = constrain(fabs(frequency), backlashFrequency/10.0F, backlashFrequency);
+    }
+
+    float fraction = (float)(millis() - backlashTakeUpStartMs)/BACKLASH_TAKEUP_RAMP;
+    if (fraction >= 1.0F) return backlashFrequency;
+    return backlashTakeUpStartFrequency + (backlashFrequency - backlashTakeUpStartFrequency)*fraction;
+  #else
+    if (inBacklash) return backlashFrequency; else return frequency;
+  #endif
+}
+
 // get the current direction of motion
 Direction Motor::getDirection() {
   if (getFrequencySteps() != 0.0F) {
@@ -14,6 +14,10 @@ enum Direction: uint8_t {DIR_NONE, DIR_FORWARD, DIR_REVERSE, DIR_BOTH};
 #define STEP_WAVE_FORM SQUARE
 #endif
 
+#ifndef BACKLASH_TAKEUP_RAMP
+#define BACKLASH_TAKEUP_RAMP OFF
+#endif
+
 class Motor {
   public:
     Motor(uint8_t axisNumber, int8_t reverse);
@@ -79,7 +83,10 @@ class Motor {
     long getBacklashSteps();
 
     // set backlash amount in steps
-    void setBacklashSteps(long value);
+    // \param value: backlash taken up on reversals toward forward
+    // \param valueReverse: backlash taken up on reversals toward reverse, -1 for the same as value,
+    // only motors that support it (step/dir) use this, others take up value both ways
+    virtual void setBacklashSteps(long value, long valueReverse = -1);
 
     // mark origin coordinate at current location
     void markOriginCoordinateSteps();
@@ -97,6 +104,9 @@ class Motor {
     // \param frequency: rate of motion in steps per second
     virtual void setFrequencyMax(float frequency) { UNUSED(frequency); }
 
+    // get the highest frequency the motor can move at, in steps per second, 0 if there's no fixed limit
+    virtual float getFrequencyLimitSteps() { return 0.0F; }
+
     // get movement frequency in steps per second
     virtual float getFrequencySteps() { return 0; }
 
@@ -106,6 +116,10 @@ class Motor {
     // set backlash frequency in steps per second
     virtual void setBacklashFrequencySteps(float frequency);
 
+    // request backlash takeup toward direction (1 or -1) ahead of an anticipated reversal, if the motor
+    // supports it this starts at the next setFrequencySteps() while stopped at the target
+    virtual void setBacklashPreload(int8_t direction) { UNUSED(direction); }
+
     // get tracking mode steps per slewing mode step
     virtual int getStepsPerStepSlewing() { return 1; }
 
@@ -137,6 +151,12 @@ class Motor {
     // get live StallGuard telemetry if the motor/driver supports it
     virtual bool getStallGuardTelemetry(char *reply, size_t replySize) { UNUSED(reply); UNUSED(replySize); return false; }
 
+    // get step ISR cost statistics if the motor supports it
+    virtual bool getIsrProfile(char *reply, size_t replySize) { UNUSED(reply); UNUSED(replySize); return false; }
+
+    // get step timing accuracy statistics if the motor supports it
+    virtual bool getStepTiming(char *reply, size_t replySize) { UNUSED(reply); UNUSED(replySize); return false; }
+
     // calibrate the motor if required
     virtual void calibrate(float value) { UNUSED(value); }
 
@@ -158,6 +178,9 @@ class Motor {
     // get the motor name
     virtual const char* name() { return NULL; }
 
+    // stop any test that drives the motor by itself (auto-tune, encoder calibration)
+    virtual void abortTests() {}
+
     // monitor and respond to motor state as required
     virtual void poll() {}
 
@@ -165,9 +188,12 @@ class Motor {
     volatile bool inBacklash = false;          // must be true if within the backlash travel
 
     volatile uint8_t monitorHandle = 0;        // handle to the axis task monitor
+    bool pollYield = true;                     // false when a motion group polls the axis, it holds rates and mustn't yield
 
     bool enabled = false;                      // enable/disable logical state
 
+    bool parametersChanged = false;            // true when the motor changed its own parameters, the axis saves them to NV
+
     bool ready = false;                        // set to true after successful init
 
     bool calibrating = false;                  // shadow disable when calibrating
@@ -179,6 +205,10 @@ class Motor {
     // enable backlash compensation, to work properly this must be proceeded by a disable call
     void enableBacklash();
 
+    // get the frequency to use for the requested frequency (in steps per second), while in backlash
+    // this is the backlash frequency ramped from the rate takeup started at over BACKLASH_TAKEUP_RAMP ms
+    float getBacklashTakeUpFrequency(float frequency);
+
     volatile uint8_t axisNumber = 0;           // axis number for this motor (1 to 9 in OnStepX)
     char axisPrefix[32];                       // prefix for debug messages
     char nameStr[40];                          // name of this motor/driver
@@ -195,6 +225,11 @@ class Motor {
     uint16_t backlashStepsStore;               // temporary storage for the position in backlash
     volatile uint16_t backlashAmountSteps = 0; // the amount of backlash travel
     uint16_t backlashAmountStepsStore;         // temporary storage for the amount of backlash travel
+    #if BACKLASH_TAKEUP_RAMP != OFF
+      bool backlashTakeUp = false;             // true once the takeup frequency ramp has started
+      unsigned long backlashTakeUpStartMs = 0;
+      float backlashTakeUpStartFrequency = 0.0F;
+    #endif
 
     long originSteps = 0;                      // start position for an autoGoto()
     volatile long targetSteps = 0;             // where we want the motor
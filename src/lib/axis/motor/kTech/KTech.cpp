@@ -180,7 +180,7 @@ void KTechMotor::setFrequencySteps(float frequency) {
   if (frequency > 0.0F) dir = 1; else if (frequency < 0.0F) { frequency = -frequency; dir = -1; }
 
   // if in backlash override the frequency
-  if (inBacklash) frequency = backlashFrequency;
+  frequency = getBacklashTakeUpFrequency(frequency);
 
   if (frequency != currentFrequency) {
     // compensate for performace limitations by taking larger steps as needed
@@ -229,7 +229,7 @@ void Mks42DMotor::setFrequencySteps(float frequency) {
   if (frequency > 0.0F) dir = 1;
   else if (frequency < 0.0F) { frequency = -frequency; dir = -1; }
 
-  if (inBacklash) frequency = backlashFrequency;
+  frequency = getBacklashTakeUpFrequency(frequency);
 
   if (frequency != currentFrequency) {
     // compensate for performance limitations by taking larger steps as needed
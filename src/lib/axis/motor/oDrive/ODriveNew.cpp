@@ -237,7 +237,7 @@ void ODriveMotor::setFrequencySteps(float frequency) {
   if (frequency > 0.0F) dir = 1; else if (frequency < 0.0F) { frequency = -frequency; dir = -1; }
 
   // if in backlash override the frequency
-  if (inBacklash) frequency = backlashFrequency;
+  frequency = getBacklashTakeUpFrequency(frequency);
 
   if (frequency != currentFrequency) {
     if (frequency < maxFrequency) stepSize = 1; else
@@ -6,6 +6,7 @@
 #ifdef SERVO_MOTOR_PRESENT
 
 #include "../../../tasks/OnTask.h"
+#include "../../../convert/Convert.h"
 #include "../Motor.h"
 
 static ServoMotor *servoMotorInstance[9];
@@ -19,6 +20,12 @@ IRAM_ATTR void moveServoMotorAxis7() { servoMotorInstance[6]->move(); }
 IRAM_ATTR void moveServoMotorAxis8() { servoMotorInstance[7]->move(); }
 IRAM_ATTR void moveServoMotorAxis9() { servoMotorInstance[8]->move(); }
 
+#if SERVO_LOOP_RATE != OFF
+  // only axis1 and axis2 can use the fast hardware timers
+  IRAM_ATTR void controlServoMotorAxis1() { servoMotorInstance[0]->controlLoop(); }
+  IRAM_ATTR void controlServoMotorAxis2() { servoMotorInstance[1]->controlLoop(); }
+#endif
+
 // constructor
 ServoMotor::ServoMotor(uint8_t axisNumber, int8_t reverse,
                        ServoDriver *Driver, Filter *filter,
@@ -60,6 +67,11 @@ ServoMotor::ServoMotor(uint8_t axisNumber, int8_t reverse,
     case 8: callback = moveServoMotorAxis8; break;
     case 9: callback = moveServoMotorAxis9; break;
   }
+
+  #if SERVO_LOOP_RATE != OFF
+    if (axisNumber == 1) controlCallback = controlServoMotorAxis1; else
+    if (axisNumber == 2) controlCallback = controlServoMotorAxis2;
+  #endif
 }
 
 bool ServoMotor::init() {
@@ -107,6 +119,34 @@ bool ServoMotor::init() {
     return false;
   }
 
+  #if SERVO_LOOP_RATE != OFF && defined(ESP32)
+    // the filters, feedback, and safety checks are float math which isn't safe in ESP32 timer ISRs
+    VF("MSG:"); V(axisPrefix); VLF("float math can't run from a timer on the ESP32, control loop stays in the axis task");
+  #elif SERVO_LOOP_RATE != OFF && !defined(CALIBRATE_SERVO_DC)
+    // run the control loop from its own hardware timer so the sample interval doesn't depend on the task scheduler
+    if (useFastHardwareTimers && controlCallback != NULL) {
+      if (!encoder->isrSafe() || !driver->isrSafe() || !filter->isrSafe()) {
+        VF("MSG:"); V(axisPrefix); VLF("encoder, driver, or filter can't run from a timer, control loop stays in the axis task");
+      } else {
+        VF("MSG:"); V(axisPrefix); VF("start fixed rate control loop task (rate "); V(SERVO_LOOP_RATE); VF("Hz)... ");
+        char loopName[] = "Ax_SvLp";
+        loopName[2] = '0' + axisNumber;
+        controlHandle = tasks.add(0, 0, true, 0, controlCallback, loopName);
+        if (controlHandle && tasks.requestHardwareTimer(controlHandle, 0)) {
+          controlPeriodUs = lround(1000000.0/SERVO_LOOP_RATE);
+          feedback->setFixedRate(controlPeriodUs);
+          driver->setUpdateRate(SERVO_LOOP_RATE);
+          fixedRateLoop = true;
+          tasks.setPeriodMicros(controlHandle, controlPeriodUs);
+          VLF("success");
+        } else {
+          if (controlHandle) { tasks.remove(controlHandle); controlHandle = 0; }
+          VLF("FAILED, no hardware timer! control loop stays in the axis task");
+        }
+      }
+    }
+  #endif
+
   ready = true;
   return true;
 }
@@ -121,10 +161,20 @@ void ServoMotor::setReverse(int8_t state) {
 void ServoMotor::enable(bool state) {
   if (!ready || state == enabled) return;
 
+  controlHold = true;
+  #if SERVO_AUTOTUNE == ON
+    autoTune.abort();
+  #endif
+  #if ENCODER_CORRECTION == ON
+    encoderCalibrate.abort();
+  #endif
   if (state) {
     driver->enable(true);         // power up first
     feedback->reset();            // clean start (PID state)
     safetyShutdown = false;
+    #ifndef SERVO_SAFETY_DISABLE
+      safety.reset();
+    #endif
 
     stopSyntheticMotion();        // stop ISR/task
     resetToTrackingBaseline();    // clear backlash/step state
@@ -137,6 +187,7 @@ void ServoMotor::enable(bool state) {
     feedback->reset();            // clear PID state
     driver->enable(false);        // then power down
   }
+  controlHold = false;
 
   #ifdef CALIBRATE_SERVO_DC
     if (enabled && !encoder->isVirtual) {
@@ -145,6 +196,18 @@ void ServoMotor::enable(bool state) {
   #endif
 }
 
+// stop auto-tune or an encoder calibration sweep, closed loop control holds wherever the motor is
+void ServoMotor::abortTests() {
+  if (!ready) return;
+
+  #if SERVO_AUTOTUNE == ON
+    autoTune.abort();
+  #endif
+  #if ENCODER_CORRECTION == ON
+    encoderCalibrate.abort();
+  #endif
+}
+
 DriverStatus ServoMotor::getDriverStatus() {
   if (!ready) return errorStatus;
 
@@ -202,12 +265,21 @@ void ServoMotor::setFrequencySteps(float frequency) {
 
   if (!enabled) { stopSyntheticMotion(); return; }
 
+  #if SERVO_AUTOTUNE == ON
+    // any commanded motion ends an auto-tune
+    if (frequency != 0.0F) autoTune.abort();
+  #endif
+  #if ENCODER_CORRECTION == ON
+    // or an encoder calibration
+    if (frequency != 0.0F) encoderCalibrate.abort();
+  #endif
+
   // negative frequency, convert to positive and reverse the direction
   int dir = 0;
   if (frequency > 0.0F) dir = 1; else if (frequency < 0.0F) { frequency = -frequency; dir = -1; }
 
   // if in backlash override the frequency
-  if (inBacklash) frequency = backlashFrequency;
+  frequency = getBacklashTakeUpFrequency(frequency);
 
   if (frequency != currentFrequency) {
     // compensate for performace limitations by taking larger steps as needed
@@ -282,8 +354,15 @@ int32_t ServoMotor::encoderRead() {
   return encoderCounts;
 }
 
-// updates PID and sets servo motor power/direction
-void ServoMotor::poll() {
+// reads the encoder, updates the feedback, and sets servo motor power/direction
+IRAM_ATTR void ServoMotor::controlLoop() {
+  // poll() is changing the feedback state, hold the last output for this sample
+  if (controlHold) return;
+
+  #if SERVO_PROFILER == ON
+    const uint32_t t0 = HAL_FAST_TICKS();
+  #endif
+
   int32_t encoderCounts = encoder->read();
   if (encoderReverse) encoderCounts = -encoderCounts;
 
@@ -309,7 +388,6 @@ void ServoMotor::poll() {
   }
 
   long unfilteredEncoderCounts = encoderCounts;
-  UNUSED(unfilteredEncoderCounts);
 
   // find encoder velocity
   float encoderVelocity = encoder->readVelocityCps();
@@ -322,7 +400,8 @@ void ServoMotor::poll() {
       lastEnc = unfilteredEncoderCounts;
       encoderVelocity = 0.0F;
     } else {
-      uint32_t dtUs = nowUs - lastUs;
+      // the fixed rate loop uses its nominal period, the timer is steadier than micros() differences
+      uint32_t dtUs = fixedRateLoop ? controlPeriodUs : nowUs - lastUs;
       if (dtUs == 0) dtUs = 1;
       encoderVelocity = (unfilteredEncoderCounts - lastEnc)*(1000000.0F/(float)dtUs);
       lastEnc = unfilteredEncoderCounts;
@@ -330,14 +409,22 @@ void ServoMotor::poll() {
     }
   }
 
-  // Eq mount tracking?
-  bool isTracking = (axisNumber == 1) && (fabsf(currentFrequency - trackingFrequency) < trackingFrequency*0.1F);
+  // steady motion (tracking, guiding, or a slow move) that periodic error can be learned from
+  bool steadyMotion = !slewing && currentFrequency > 0.0F;
+
+  filter->setCommandedVelocity(currentDirection*currentFrequency);
+  encoderCounts = filter->update(encoderCounts, motorCounts, steadyMotion);
 
-  encoderCounts = filter->update(encoderCounts, motorCounts, isTracking);
+  // a filter that estimates velocity gives a cleaner signal than the encoder
+  float filterVelocity = filter->velocity();
+  if (!isnan(filterVelocity)) encoderVelocity = filterVelocity;
 
   control->set = motorCounts;
   control->in = encoderCounts;
+  control->velocitySet = currentDirection*currentFrequency;
+  control->velocityIn = encoderVelocity;
   float velocity;
+  bool closedLoop = true;
   if (enabled) {
     // directly use fixed PWM value during calibration
     #ifdef CALIBRATE_SERVO_DC
@@ -348,17 +435,48 @@ void ServoMotor::poll() {
         velocity = (calibrateVelocity->experimentVelocity/100.0F)*velocityMax;
         // disable the PID                        // or feedback->zeroOutputs()
         control->out = 0.0f;                      // ensure PID output doesn't leak in
+        closedLoop = false;
       } else {
         // your normal control path; keep whatever you used before
         velocity = control->out + currentDirection*currentFrequency;
       }
     #else
-      feedback->poll();
-      velocity = control->out + currentDirection*currentFrequency;
+      #if ENCODER_CORRECTION == ON
+        if (encoderCalibrate.active()) {
+          // the sweep drives the motor directly during encoder calibration, the motor position
+          // follows the axis so closed loop control carries on from wherever the sweep ends
+          velocity = encoderCalibrate.update(encoder->turnCount);
+          control->out = 0.0F;
+          closedLoop = false;
+          noInterrupts();
+          motorSteps = unfilteredEncoderCounts;
+          targetSteps = unfilteredEncoderCounts;
+          backlashSteps = 0;
+          interrupts();
+        } else
+      #endif
+      #if SERVO_AUTOTUNE == ON
+        if (autoTune.active()) {
+          // the relay drives the motor directly during auto-tune
+          velocity = autoTune.update(encoderCounts);
+          control->out = 0.0F;
+          closedLoop = false;
+        } else
+      #endif
+      {
+        feedback->poll();
+        velocity = control->out;
+        if (!feedback->feedForward) velocity += currentDirection*currentFrequency;
+      }
     #endif
 
   } else velocity = 0.0F;
 
+  #ifndef SERVO_SAFETY_DISABLE
+    // the safety monitor tripped, hold the motor stopped until poll() disables it
+    if (safety.tripped()) velocity = 0.0F;
+  #endif
+
   // for virtual encoders set the velocity and direction
   if (encoder->isVirtual) {
     encoderDirection = velocity < 0.0F ? -1 : 1;
@@ -372,8 +490,78 @@ void ServoMotor::poll() {
   velocityPercent = (driver->setMotorVelocity(velocity, encoderVelocity)/velocityMax)*100.0F;
   if (driver->getMotorDirection() == DIR_FORWARD) control->directionHint = 1; else control->directionHint = -1;
 
+  #ifndef SERVO_SAFETY_DISABLE
+    // checked every sample so a fault stops the motor here, without waiting for poll()
+    if (enabled && safety.check(motorCounts, unfilteredEncoderCounts, velocity, encoderVelocity, velocityPercent, closedLoop)) {
+      driver->setMotorVelocity(0.0F, encoderVelocity);
+      velocityPercent = 0.0F;
+    }
+  #else
+    UNUSED(closedLoop);
+  #endif
+
+  controlMotorCounts = motorCounts;
+  controlEncoderCounts = encoderCounts;
+  controlUnfilteredCounts = unfilteredEncoderCounts;
+
+  #if SERVO_PROFILER == ON
+    profiler.sample(t0, motorCounts - unfilteredEncoderCounts, control->velocitySet);
+  #endif
+}
+
+// safety checks and feedback parameter switching, also runs the control loop unless it has its own timer
+void ServoMotor::poll() {
+  if (!fixedRateLoop) controlLoop();
+
+  noInterrupts();
+  long motorCounts = controlMotorCounts;
+  long encoderCounts = controlEncoderCounts;
+  long unfilteredEncoderCounts = controlUnfilteredCounts;
+  interrupts();
+  UNUSED(unfilteredEncoderCounts);
+
   const unsigned long now = millis();
 
+  // the fixed rate control loop is held off while the feedback parameters change
+  controlHold = true;
+  #if SERVO_AUTOTUNE == ON
+    // the relay test has its cycles, set the gains and resume closed loop control
+    if (autoTune.state == AT_ANALYZE) {
+      if (autoTune.analyze() && feedback->applyTuning(autoTune.ultimateGain, autoTune.ultimatePeriod)) {
+        parametersChanged = true;
+        VF("MSG:"); V(axisPrefix); VLF("auto-tune complete");
+      } else {
+        DF("WRN:"); D(axisPrefix); DLF("auto-tune failed, gains unchanged");
+      }
+      feedback->reset();
+      autoTuneReported = true;
+    } else
+    if (autoTune.state == AT_FAILED && !autoTuneReported) {
+      DF("WRN:"); D(axisPrefix); DLF("auto-tune failed, gains unchanged");
+      feedback->reset();
+      autoTuneReported = true;
+    }
+  #endif
+  #if ENCODER_CORRECTION == ON
+    // the sweep has covered a turn, find the correction and resume closed loop control
+    if (encoderCalibrate.state == EC_ANALYZE) {
+      EncoderCorrection harmonics;
+      if (encoderCalibrate.analyze(harmonics) && encoder->setCorrection(harmonics)) {
+        VF("MSG:"); V(axisPrefix); VLF("encoder calibration complete");
+      } else {
+        DF("WRN:"); D(axisPrefix); DLF("encoder calibration failed, correction unchanged");
+      }
+      encoder->correctionEnable(true);
+      feedback->reset();
+      encoderCalibrateReported = true;
+    } else
+    if (encoderCalibrate.state == EC_FAILED && !encoderCalibrateReported) {
+      DF("WRN:"); D(axisPrefix); DLF("encoder calibration failed, correction unchanged");
+      encoder->correctionEnable(true);
+      feedback->reset();
+      encoderCalibrateReported = true;
+    }
+  #endif
   if (feedback->manuallySwitchParameters) {
     if (!slewing && enabled) {
       if (now - lastSlewingTime >= SERVO_SLEWING_TO_TRACKING_DELAY) feedback->selectTrackingParameters(); else feedback->selectSlewingParameters();
@@ -381,54 +569,30 @@ void ServoMotor::poll() {
       lastSlewingTime = now;
       feedback->selectSlewingParameters();
     }
+    feedback->pollParameters();
   } else {
     feedback->variableParameters(fabs(velocityPercent));
   }
-
-  if (velocityPercent < -33) wasBelow33 = true;
-  if (velocityPercent > 33) wasAbove33 = true;
-
-  if (now - lastCheckTime >= 1000U) {
-    delta = motorCounts - encoderCounts;
-
-    #ifndef SERVO_SAFETY_DISABLE
-      // if above SERVO_SAFETY_STALL_POWER (33% default) and we're not moving something is seriously wrong, so shut it down
-      if (labs(encoderCounts - lastEncoderCounts) < 10 && abs(velocityPercent) >= SERVO_SAFETY_STALL_POWER) {
-        DF("WRN:"); D(axisPrefix); DF("stall detected!");
-        DF(" control->in = "); D(control->in); DF(", control->set = "); D(control->set);
-        DF(", control->out = "); D(control->out); DF(", velocity % = "); DL(velocityPercent);
-        enable(false);
-        safetyShutdown = true;
-      }
-
-      // if above 90% power for > three seconds and the distance to the target is increasing
-      // something is seriously wrong so shut it down
-      if (labs(delta - lastDelta) > lastTargetDistance && abs(velocityPercent) >= 90) {
-        movingAwaySeconds++;
-        if (movingAwaySeconds >= 3) {
-          DF("WRN:"); D(axisPrefix); DF("runaway detected!");
-          DLF(" > 90% power while moving away from the target!");
-          enable(false);
-          safetyShutdown = true;
+  controlHold = false;
+
+  delta = motorCounts - encoderCounts;
+
+  #ifndef SERVO_SAFETY_DISABLE
+    // the safety monitor stopped the motor in the control loop, now shut it down
+    if (safety.tripped() && enabled) {
+      DF("WRN:"); D(axisPrefix); D(safety.tripName()); DF(" detected, ");
+      if (safety.tripFast) { DLF("fast trip!"); } else { DLF("slow trip!"); }
+      #if DEBUG == VERBOSE
+        VF("MSG:"); V(axisPrefix); VLF("before the trip ms,motor,encoder,velocity command,velocity,power %");
+        char record[80];
+        for (int i = SERVO_SAFETY_RECORDS - 1; i >= 0; i--) {
+          if (safety.getRecord(i, record, sizeof(record))) { VF("MSG:"); V(axisPrefix); VL(record); }
         }
-      } else movingAwaySeconds = 0;
-      lastTargetDistance = labs(delta - lastDelta);
-
-      // if we were below -33% and above 33% power in a one second period something is seriously wrong, so shut it down
-      if (wasBelow33 && wasAbove33) {
-        DF("WRN:"); D(axisPrefix); DF("oscillation detected!");
-        DLF(" below -33% and above 33% power in a 2 second period!");
-        enable(false);
-        safetyShutdown = true;
-      }
-    #endif
-
-    wasAbove33 = false;
-    wasBelow33 = false;
-    lastEncoderCounts = encoderCounts;
-    lastDelta = delta;
-    lastCheckTime = now;
-  }
+      #endif
+      enable(false);
+      safetyShutdown = true;
+    }
+  #endif
 
   #if DEBUG != OFF && defined(DEBUG_AXIS) && DEBUG_AXIS != OFF
     if (axisNumber == DEBUG_AXIS) {
@@ -453,6 +617,110 @@ void ServoMotor::poll() {
   #endif
 }
 
+#if SERVO_AUTOTUNE == ON
+  // start a relay auto-tune about the current position, the relay velocity is in % of the maximum
+  CommandError ServoMotor::autoTuneStart(float percent) {
+    if (!ready) return CE_0;
+    if (percent < 1.0F || percent > 25.0F) return CE_PARAM_RANGE;
+    if (!enabled) return CE_SLEW_ERR_IN_STANDBY;
+    if (currentFrequency != 0.0F || slewing || autoTune.active()) return CE_SLEW_IN_MOTION;
+    #if ENCODER_CORRECTION == ON
+      if (encoderCalibrate.active()) return CE_SLEW_IN_MOTION;
+    #endif
+
+    VF("MSG:"); V(axisPrefix); VF("auto-tune start, relay at "); V(percent); VLF("%");
+
+    noInterrupts();
+    long center = controlEncoderCounts;
+    interrupts();
+
+    controlHold = true;
+    autoTuneReported = false;
+    autoTune.start(center, (percent/100.0F)*velocityMax);
+    controlHold = false;
+    return CE_NONE;
+  }
+
+  // get the auto-tune state and the ultimate gain and period
+  void ServoMotor::autoTuneStatus(char *reply) {
+    int state = 0;
+    if (autoTune.state == AT_RELAY || autoTune.state == AT_ANALYZE) state = 1; else
+    if (autoTune.state == AT_DONE) state = 2; else
+    if (autoTune.state == AT_FAILED) state = 3;
+
+    char ku[16], tu[16];
+    sprintF(ku, "%0.4f", autoTune.ultimateGain);
+    sprintF(tu, "%0.4f", autoTune.ultimatePeriod);
+    sprintf(reply, "%d,%s,%s", state, ku, tu);
+  }
+#endif
+
+#if ENCODER_CORRECTION == ON
+  // start an absolute encoder calibration sweep of one turn, the velocity is in % of the maximum (negative reverses)
+  CommandError ServoMotor::encoderCalibrateStart(float percent, long roomForward, long roomReverse) {
+    if (!ready) return CE_0;
+    if (encoder->countsPerTurn() == 0) return CE_CMD_UNKNOWN;
+    if (fabsf(percent) < 0.1F || fabsf(percent) > 25.0F) return CE_PARAM_RANGE;
+    if (!enabled) return CE_SLEW_ERR_IN_STANDBY;
+    if (currentFrequency != 0.0F || slewing || encoderCalibrate.active()) return CE_SLEW_IN_MOTION;
+    #if SERVO_AUTOTUNE == ON
+      if (autoTune.active()) return CE_SLEW_IN_MOTION;
+    #endif
+
+    // the sweep covers a full turn of the encoder plus the run up to speed (in steps), a partial turn
+    // isn't fit so on an encoder that turns with the axis (not the motor) that's all the way around
+    const float velocity = (percent/100.0F)*velocityMax;
+    const long travel = (long)encoder->stepsPerTurn() + lroundf(fabsf(velocity)*(ENCODER_CALIBRATE_SETTLE_MS/1000.0F));
+    if (travel > (velocity > 0.0F ? roomForward : roomReverse)) {
+      VF("MSG:"); V(axisPrefix); VLF("encoder calibration refused, a full encoder turn would pass a limit");
+      return CE_SLEW_ERR_OUTSIDE_LIMITS;
+    }
+
+    VF("MSG:"); V(axisPrefix); VF("encoder calibration start, one turn at "); V(percent); VLF("%");
+
+    // the encoder is measured as it is, without the correction
+    controlHold = true;
+    encoderCalibrateReported = false;
+    encoder->correctionEnable(false);
+    encoderCalibrate.start(velocity, encoder->countsPerTurn());
+    controlHold = false;
+    return CE_NONE;
+  }
+
+  // forget the absolute encoder correction
+  CommandError ServoMotor::encoderCorrectionClear() {
+    if (!ready) return CE_0;
+    if (encoder->countsPerTurn() == 0) return CE_CMD_UNKNOWN;
+    if (encoderCalibrate.active()) return CE_SLEW_IN_MOTION;
+
+    encoder->clearCorrection();
+    return CE_NONE;
+  }
+
+  // get the encoder calibration state, the peak error corrected, the rms error left, and if a correction is in use
+  void ServoMotor::encoderCalibrateStatus(char *reply) {
+    int state = 0;
+    if (encoderCalibrate.state == EC_SWEEP || encoderCalibrate.state == EC_ANALYZE) state = 1; else
+    if (encoderCalibrate.state == EC_DONE) state = 2; else
+    if (encoderCalibrate.state == EC_FAILED) state = 3;
+
+    char peak[16], rms[16];
+    sprintF(peak, "%0.1f", encoderCalibrate.amplitude);
+    sprintF(rms, "%0.1f", encoderCalibrate.residual);
+    sprintf(reply, "%d,%s,%s,%d", state, peak, rms, encoder->getCorrection().countsPerTurn != 0 ? 1 : 0);
+  }
+#endif
+
+#if SERVO_PROFILER == ON
+  // get tracking error statistics since the last call, or the tracking error spectrum
+  bool ServoMotor::getTrackingProfile(char *reply, size_t replySize, bool spectrum) {
+    if (!ready) return false;
+
+    if (spectrum) profiler.getSpectrum(reply, replySize); else profiler.getTracking(reply, replySize);
+    return true;
+  }
+#endif
+
 void ServoMotor::stopSyntheticMotion() {
   if (lastPeriod == 0 && step == 0 && absStep == 0) return;
   currentFrequency = 0.0F;
@@ -5,10 +5,15 @@
 
 #ifdef SERVO_MOTOR_PRESENT
 
+#include "../../../commands/CommandErrors.h"
 #include "../../../encoder/Encoder.h"
 #include "filter/Filter.h"
 #include "feedback/Feedback.h"
 #include "dc/calibration/TrackingVelocity.h"
+#include "tune/AutoTune.h"
+#include "tune/EncoderCalibrate.h"
+#include "profiler/Profiler.h"
+#include "safety/Safety.h"
 
 #include "dc/eE/EE.h"
 #include "dc/pE/PE.h"
@@ -17,6 +22,8 @@
 #include "kTech/KTech.h"
 #include "tmc/tmc2209/Tmc2209.h"
 #include "tmc/tmc5160/Tmc5160.h"
+#include "sim/ServoSim.h"
+#include "sim/SimEncoder.h"
 
 #ifndef SERVO_SLEW_DIRECT
   #define SERVO_SLEW_DIRECT OFF
@@ -26,8 +33,8 @@
   #define SERVO_SLEWING_TO_TRACKING_DELAY 3000 // in milliseconds
 #endif
 
-#ifndef SERVO_SAFETY_STALL_POWER
-  #define SERVO_SAFETY_STALL_POWER 33 // in percent
+#ifndef SERVO_LOOP_RATE
+  #define SERVO_LOOP_RATE OFF // in Hz, OFF runs the control loop from poll()
 #endif
 
 class ServoMotor : public Motor {
@@ -84,6 +91,9 @@ class ServoMotor : public Motor {
       if (velocityMax < 1.0F) velocityMax = 1.0F;
       driver->setFrequencyMax(frequency*1.1F);
       feedback->setControlRange(frequency*1.1F);
+      #ifndef SERVO_SAFETY_DISABLE
+        safety.setVelocityMax(velocityMax);
+      #endif
     }
 
     // get movement frequency in steps per second
@@ -95,6 +105,9 @@ class ServoMotor : public Motor {
     // set slewing state (hint that we are about to slew or are done slewing)
     void setSlewing(bool state);
 
+    // stop auto-tune or an encoder calibration sweep
+    void abortTests();
+
     // calibrate the motor driver
     void calibrateDriver() { if (ready) driver->calibrateDriver(); }
 
@@ -115,11 +128,52 @@ class ServoMotor : public Motor {
     // get the motor name
     const char* name() { strcpy(nameStr, "Servo, "); strcat(nameStr, driver->name()); return nameStr; }
 
-    // updates PID and sets servo motor power/direction
+    // safety checks and feedback parameter switching, also runs the control loop unless it has its own timer
     void poll();
 
+    // reads the encoder, updates the feedback, and sets servo motor power/direction
+    void controlLoop();
+
     // sets dir as required and moves coord toward target at setFrequencySteps() rate
     void move();
+
+    #if SERVO_AUTOTUNE == ON
+      // start a relay auto-tune about the current position, the relay velocity is in % of the maximum
+      CommandError autoTuneStart(float percent);
+
+      // get the auto-tune state (0 idle, 1 running, 2 done, 3 failed) and the ultimate gain and period
+      void autoTuneStatus(char *reply);
+    #endif
+
+    #if ENCODER_CORRECTION == ON
+      // start an absolute encoder calibration sweep of one turn, the velocity is in % of the maximum (negative reverses)
+      // \param roomForward: steps the axis can move forward, the sweep is refused if it needs more
+      // \param roomReverse: steps the axis can move in reverse
+      CommandError encoderCalibrateStart(float percent, long roomForward, long roomReverse);
+
+      // forget the absolute encoder correction
+      CommandError encoderCorrectionClear();
+
+      // get the encoder calibration state (0 idle, 1 running, 2 done, 3 failed), the peak error corrected,
+      // the rms error left, and if a correction is in use
+      void encoderCalibrateStatus(char *reply);
+    #endif
+
+    #ifndef SERVO_SAFETY_DISABLE
+      // get the safety monitor trip as reason,tier
+      void getSafetyTrip(char *reply) { safety.getTrip(reply); }
+
+      // get a record of the state before a safety trip, 0 is the latest
+      bool getSafetyRecord(int number, char *reply, size_t replySize) { return safety.getRecord(number, reply, replySize); }
+    #endif
+
+    #if SERVO_PROFILER == ON
+      // get control loop cost in fast ticks as min,avg,max since the last call
+      bool getIsrProfile(char *reply, size_t replySize) { if (!ready) return false; profiler.getCost(reply, replySize); return true; }
+
+      // get tracking error statistics since the last call, or the tracking error spectrum
+      bool getTrackingProfile(char *reply, size_t replySize, bool spectrum);
+    #endif
     
     // servo motor driver
     ServoDriver *driver;
@@ -137,15 +191,38 @@ class ServoMotor : public Motor {
     Filter *filter;
 
     void (*callback)() = NULL;
+    void (*controlCallback)() = NULL;
 
     Feedback *feedback;
     ServoControl *control;
     #ifdef CALIBRATE_SERVO_DC
       ServoCalibrateTrackingVelocity *calibrateVelocity;
     #endif
+    #if SERVO_AUTOTUNE == ON
+      ServoAutoTune autoTune;
+      bool autoTuneReported = true;
+    #endif
+    #if ENCODER_CORRECTION == ON
+      ServoEncoderCalibrate encoderCalibrate;
+      bool encoderCalibrateReported = true;
+    #endif
+    #if SERVO_PROFILER == ON
+      ServoProfiler profiler;
+    #endif
+    #ifndef SERVO_SAFETY_DISABLE
+      ServoSafety safety;
+    #endif
 
     uint8_t servoMonitorHandle = 0;
     uint8_t taskHandle = 0;
+    uint8_t controlHandle = 0;
+
+    bool fixedRateLoop = false;         // true if controlLoop() runs from its own hardware timer
+    uint32_t controlPeriodUs = 0;       // fixed rate control loop period
+    volatile bool controlHold = false;  // true while poll() changes feedback state, the control loop skips a sample
+    volatile long controlMotorCounts = 0;      // last control loop sample, for poll()
+    volatile long controlEncoderCounts = 0;
+    volatile long controlUnfilteredCounts = 0;
 
     float maxFrequency = HAL_FRACTIONAL_SEC; // fastest timer rate
     float maxFrequency2, maxFrequency4, maxFrequency8, maxFrequency16, maxFrequency32, maxFrequency64, maxFrequency128;
@@ -174,17 +251,8 @@ class ServoMotor : public Motor {
     float velocityMax = 0.0F;           // the maximum velocity allowed
 
     volatile int absStep = 1;           // absolute step size (unsigned)
-    // servo safety checks
-    unsigned long lastCheckTime = 0;    // time since the last encoder position was checked
-    unsigned long startTime = 0;        // time at start of servo polling
     unsigned long lastSlewingTime = 0;  // time when last slewing
-    long lastEncoderCounts = 0;         // the last encoder position for stall check
-    long movingAwaySeconds = 0;         // amount of time for runaway check
-    long lastTargetDistance = 0;        // check if moving away from target for runaway check
-    long lastDelta = 0;                 // the last distance from target for runaway check
-    bool wasAbove33 = false;            // check for oscillation
-    bool wasBelow33 = false;            // check for oscillation
-    bool safetyShutdown = false;
+    bool safetyShutdown = false;        // the safety monitor tripped and the motor was disabled
 };
 
 #endif
@@ -21,7 +21,8 @@
     "SERVO_TMC5160_DC", // TMC5160 w/ DC motor
     "SERVO_TMC2209",    // TMC2209 w/ stepper motor
     "SERVO_TMC5160",    // TMC5160 w/ stepper motor
-    "SERVO_KTECH"       // KTech servo motor using velocity control
+    "SERVO_KTECH",      // KTech servo motor using velocity control
+    "SERVO_SIM"         // simulated DC motor and gear train
   };
 #endif
 
@@ -91,11 +92,11 @@ void ServoDriver::setFrequencyMax(float frequency) {
   InvVelocityMax = 1.0F/frequency;
 
   normalizedAcceleration = (acceleration.value/100.0F)*velocityMax;
-  accelerationFs = normalizedAcceleration/FRACTIONAL_SEC;
+  accelerationFs = normalizedAcceleration/updateRate;
 
   // show velocity control settings
   VF("MSG:"); V(axisPrefix); VF("Vmax="); V(velocityMax); VLF(" steps/s");
-  VF("MSG:"); V(axisPrefix); VF("Acceleration="); V(acceleration.value); VF("%/s/s ("); V(accelerationFs); VLF(" steps/s/fs)");
+  VF("MSG:"); V(axisPrefix); VF("Acceleration="); V(acceleration.value); VF("%/s/s ("); V(accelerationFs); VLF(" steps/s/update)");
 }
 
 float ServoDriver::setMotorVelocity(float velocity) {
@@ -56,6 +56,13 @@ class ServoDriver {
     // \param frequency: rate of motion in steps (counts) per second
     void setFrequencyMax(float frequency);
 
+    // sets the rate setMotorVelocity() is called at so acceleration is applied correctly
+    // \param rate: calls per second
+    void setUpdateRate(float rate) { updateRate = rate; accelerationFs = normalizedAcceleration/updateRate; }
+
+    // true if setMotorVelocity() is quick and bounded so it can be called from a timer ISR
+    virtual bool isrSafe() { return false; }
+
     // set motor velocity
     // \param velocity as needed to reach the target position, in signed encoder counts per second
     virtual float setMotorVelocity(float velocity);
@@ -104,8 +111,9 @@ class ServoDriver {
     #endif
     unsigned long timeLastStatusUpdate = 0;
 
-    float normalizedAcceleration; // in encoder counts/s/s
-    float accelerationFs;         // in encoder counts/s/fs
+    float normalizedAcceleration = 0.0F; // in encoder counts/s/s
+    float accelerationFs = 0.0F;  // in encoder counts/s per update
+    float updateRate = FRACTIONAL_SEC; // setMotorVelocity() calls per second
     float velocityRamp = 1.0F;    // regulate velocity changes
     float velocityMax = 1.0F;     // frequency corrosponding to the fastest allowed slew rate, in encoder counts/s
     float InvVelocityMax = 1.0F;
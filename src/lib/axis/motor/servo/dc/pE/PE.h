@@ -23,6 +23,9 @@ class ServoPE : public ServoDcDriver {
     // update status info. for driver
     void updateStatus();
 
+    // pwm and direction pin writes only
+    bool isrSafe() { return true; }
+
     // get the driver name
     const char* name() {
       if (driverModel == SERVO_PE) return "DC Phase/Enable" ; else
@@ -0,0 +1,127 @@
+// -----------------------------------------------------------------------------------
+// servo motor cascaded position/velocity feedback
+
+#include "Cascade.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+#if AXIS1_SERVO_FEEDBACK == CASCADE || AXIS2_SERVO_FEEDBACK == CASCADE || AXIS3_SERVO_FEEDBACK == CASCADE || \
+    AXIS4_SERVO_FEEDBACK == CASCADE || AXIS5_SERVO_FEEDBACK == CASCADE || AXIS6_SERVO_FEEDBACK == CASCADE || \
+    AXIS7_SERVO_FEEDBACK == CASCADE || AXIS8_SERVO_FEEDBACK == CASCADE || AXIS9_SERVO_FEEDBACK == CASCADE
+
+Cascade::Cascade(const float positionP, const float velocityP, const float velocityI, const float velocityFF, const float accelerationFF) {
+  this->positionP.valueDefault = positionP;
+  this->velocityP.valueDefault = velocityP;
+  this->velocityI.valueDefault = velocityI;
+  this->velocityFF.valueDefault = velocityFF;
+  this->accelerationFF.valueDefault = accelerationFF;
+
+  // the output includes the commanded velocity, and there is only one parameter set
+  feedForward = true;
+  manuallySwitchParameters = false;
+}
+
+// initialize feedback control and parameters
+void Cascade::init(uint8_t axisNumber, ServoControl *control) {
+  if (ready) return;
+
+  Feedback::init(axisNumber, control);
+
+  axisPrefix[5] = '0' + axisNumber;
+
+  VF("MSG:"); V(axisPrefix); VF("sample time "); V(sampleTimeUs); VLF("us");
+}
+
+// reset feedback control and parameters
+void Cascade::reset() {
+  if (!ready) return;
+
+  VF("MSG:"); V(axisPrefix); VLF("reset");
+  control->in = 0;
+  control->set = 0;
+  control->out = 0;
+  control->velocityIn = 0;
+  control->velocitySet = 0;
+  integral = 0.0F;
+  accelerationSet = 0.0F;
+  primed = false;
+  lastSampleTime = micros();
+}
+
+void Cascade::setControlDirection(int8_t state) {
+  if (!ready) return;
+
+  controlDirection = (state == ON) ? -1.0F : 1.0F;
+}
+
+void Cascade::setControlRange(float controlRange) {
+  if (!ready) return;
+
+  VF("MSG:"); V(axisPrefix); VF("setting feedback range +/-"); VL(controlRange);
+  this->controlRange = controlRange;
+}
+
+void Cascade::setFixedRate(unsigned long periodUs) {
+  if (!ready) return;
+
+  VF("MSG:"); V(axisPrefix); VF("fixed rate sample time "); V(periodUs); VLF("us");
+  sampleTimeUs = periodUs;
+  fixedRate = true;
+}
+
+// set the gains from a relay test, the velocity loop proportional gain and feed-forward are left alone
+bool Cascade::applyTuning(float ultimateGain, float ultimatePeriod) {
+  if (!ready || !(ultimateGain > 0.0F) || !(ultimatePeriod > 0.0F)) return false;
+
+  // Ziegler-Nichols PI rule, the integral acts on the velocity error
+  setTuned(&positionP, ultimateGain*0.45F);
+  setTuned(&velocityI, 1.2F/ultimatePeriod);
+  integral = 0.0F;
+
+  VF("MSG:"); V(axisPrefix); VF("tuned position Kp="); V(positionP.value); VF(", velocity Ki="); VL(velocityI.value);
+  return true;
+}
+
+void Cascade::poll() {
+  if (!fixedRate) {
+    unsigned long now = micros();
+    if ((long)(now - lastSampleTime) < (long)sampleTimeUs) return;
+
+    // keep to the sample grid unless a whole sample was missed
+    lastSampleTime += sampleTimeUs;
+    if ((long)(now - lastSampleTime) >= (long)sampleTimeUs) lastSampleTime = now;
+  }
+
+  update(sampleTimeUs/1000000.0F);
+}
+
+void Cascade::update(float dt) {
+  // commanded acceleration from the change in commanded velocity
+  float velocitySet = control->velocitySet;
+  if (!primed) { lastVelocitySet = velocitySet; primed = true; }
+  accelerationSet += ((velocitySet - lastVelocitySet)/dt - accelerationSet)*CASCADE_ACCEL_FILTER;
+  lastVelocitySet = velocitySet;
+
+  // outer loop, the velocity needed to close the position error
+  float velocityDemand = positionP.value*(control->set - control->in);
+  if (controlRange > 0.0F) velocityDemand = constrain(velocityDemand, -controlRange, controlRange);
+
+  // inner loop, correct the measured velocity toward the commanded plus demanded velocity
+  float velocityError = (velocitySet + velocityDemand) - control->velocityIn;
+  float correction = velocityDemand + velocityP.value*velocityError + integral;
+
+  // integrate only while unsaturated or when the error would unwind the integral
+  bool saturated = controlRange > 0.0F && fabsf(correction) >= controlRange;
+  if (!saturated || (correction > 0.0F) != (velocityError > 0.0F)) {
+    integral += velocityI.value*velocityError*dt;
+    if (controlRange > 0.0F) integral = constrain(integral, -controlRange, controlRange);
+  }
+
+  if (controlRange > 0.0F) correction = constrain(correction, -controlRange, controlRange);
+
+  control->out = controlDirection*correction + velocityFF.value*velocitySet + accelerationFF.value*accelerationSet;
+}
+
+#endif
+
+#endif
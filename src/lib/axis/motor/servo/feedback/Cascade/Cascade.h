@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------------
+// servo motor cascaded position/velocity feedback
+#pragma once
+
+#include "../FeedbackBase.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+#if AXIS1_SERVO_FEEDBACK == CASCADE || AXIS2_SERVO_FEEDBACK == CASCADE || AXIS3_SERVO_FEEDBACK == CASCADE || \
+    AXIS4_SERVO_FEEDBACK == CASCADE || AXIS5_SERVO_FEEDBACK == CASCADE || AXIS6_SERVO_FEEDBACK == CASCADE || \
+    AXIS7_SERVO_FEEDBACK == CASCADE || AXIS8_SERVO_FEEDBACK == CASCADE || AXIS9_SERVO_FEEDBACK == CASCADE
+
+#ifndef CASCADE_SAMPLE_TIME_US
+  #define CASCADE_SAMPLE_TIME_US 10000 // loop sample time in microseconds (defaults to 10 milliseconds)
+#endif
+#ifndef CASCADE_ACCEL_FILTER
+  #define CASCADE_ACCEL_FILTER 0.2F    // smoothing of the commanded acceleration, 0 to 1 (1 for none)
+#endif
+
+// outer position loop (P) feeding an inner velocity loop (PI) with velocity and acceleration feed-forward
+// from the commanded trajectory, all terms are in encoder counts and counts per second
+class Cascade : public Feedback {
+  public:
+    Cascade(const float positionP, const float velocityP, const float velocityI, const float velocityFF, const float accelerationFF);
+
+    // initialize feedback control and parameters
+    void init(uint8_t axisNumber, ServoControl *control);
+
+    // reset feedback control and parameters
+    void reset();
+
+    // returns the number of axis parameters
+    uint8_t getParameterCount() { return numParameters; }
+
+    // returns the specified axis parameter
+    AxisParameter* getParameter(uint8_t number) { if (number > numParameters) return &invalid; else return parameter[number]; }
+
+    // set feedback control direction
+    void setControlDirection(int8_t state);
+
+    // set feedback control range
+    void setControlRange(float controlRange);
+
+    // the gains are the same for tracking and slewing
+    void selectTrackingParameters() {}
+    void selectSlewingParameters() {}
+    void variableParameters(float percent) { UNUSED(percent); }
+
+    // run update() on every poll() with a sample time of periodUs
+    void setFixedRate(unsigned long periodUs);
+
+    // position loop gain and velocity loop integral from a relay test
+    bool applyTuning(float ultimateGain, float ultimatePeriod);
+
+    // run the loop once for each sample period that has passed
+    void poll();
+
+    // run the loop once, dt is the sample period in seconds
+    void update(float dt);
+
+  private:
+    char axisPrefix[26] = " Axis_ServoFeedbackCscd, "; // prefix for debug messages
+
+    float controlRange = 0.0F;
+    float controlDirection = 1.0F;
+
+    float integral = 0.0F;                // inner loop integral term, counts/s
+    float lastVelocitySet = 0.0F;         // for the commanded acceleration
+    float accelerationSet = 0.0F;         // filtered commanded acceleration, counts/s/s
+    bool primed = false;                  // true once lastVelocitySet is valid
+
+    unsigned long lastSampleTime = 0;
+    unsigned long sampleTimeUs = CASCADE_SAMPLE_TIME_US;
+    bool fixedRate = false;
+
+    // runtime adjustable settings
+    AxisParameter positionP      = {NAN, NAN, NAN, 0.0, 1000.0, AXP_FLOAT_IMMEDIATE, "Position Kp"};
+    AxisParameter velocityP      = {NAN, NAN, NAN, 0.0, 100.0,  AXP_FLOAT_IMMEDIATE, "Velocity Kp"};
+    AxisParameter velocityI      = {NAN, NAN, NAN, 0.0, 1000.0, AXP_FLOAT_IMMEDIATE, "Velocity Ki"};
+    AxisParameter velocityFF     = {NAN, NAN, NAN, 0.0, 2.0,    AXP_FLOAT_IMMEDIATE, "Velocity FF"};
+    AxisParameter accelerationFF = {NAN, NAN, NAN, 0.0, 1.0,    AXP_FLOAT_IMMEDIATE, "Accel FF"};
+
+    const int numParameters = 5;
+    AxisParameter* parameter[6] = {&invalid, &positionP, &velocityP, &velocityI, &velocityFF, &accelerationFF};
+};
+
+#endif
+
+#endif
@@ -66,6 +66,39 @@ void DualPid::setControlRange(float controlRange) {
   pid->SetOutputLimits(-controlRange, controlRange);
 }
 
+void DualPid::setFixedRate(unsigned long periodUs) {
+  if (!ready) return;
+
+  VF("MSG:"); V(axisPrefix); VF("fixed rate sample time "); V(periodUs); VLF("us");
+  pid->SetSampleTimeUs(periodUs);
+  pid->SetMode(QuickPID::Control::timer);
+}
+
+// set the gains from a relay test
+bool DualPid::applyTuning(float ultimateGain, float ultimatePeriod) {
+  if (!ready || !(ultimateGain > 0.0F) || !(ultimatePeriod > 0.0F)) return false;
+
+  // tracking favors low overshoot and robustness over speed of response
+  float p = ultimateGain/2.2F;
+  setTuned(&trackingP, p);
+  setTuned(&trackingI, p/(2.2F*ultimatePeriod));
+  setTuned(&trackingD, p*ultimatePeriod/6.3F);
+
+  // slewing favors a fast response
+  p = ultimateGain*0.6F;
+  setTuned(&slewingP, p);
+  setTuned(&slewingI, p/(0.5F*ultimatePeriod));
+  setTuned(&slewingD, p*ultimatePeriod*0.125F);
+
+  VF("MSG:"); V(axisPrefix); VF("tuned tracking P="); V(trackingP.value); VF(", I="); V(trackingI.value); VF(", D="); VL(trackingD.value);
+  VF("MSG:"); V(axisPrefix); VF("tuned slewing P="); V(slewingP.value); VF(", I="); V(slewingI.value); VF(", D="); VL(slewingD.value);
+
+  // use the new gains now
+  if (trackingSelected) pid->SetTunings(trackingP.value, trackingI.value, trackingD.value); else pid->SetTunings(slewingP.value, slewingI.value, slewingD.value);
+  lastP = NAN;
+  return true;
+}
+
 // select PID param set for tracking
 void DualPid::selectTrackingParameters() {
   if (!trackingSelected) {
@@ -94,6 +127,18 @@ void DualPid::selectSlewingParameters() {
   }
 }
 
+// ramp from the slewing to the tracking parameters
+void DualPid::pollParameters() {
+  if (!manuallySwitchParameters) return;
+
+  if ((long)(millis() - nextSelectIncrementTime) > 0) {
+    if (trackingSelected) parameterSelectPercent--;
+    if (parameterSelectPercent < 0) parameterSelectPercent = 0;
+    variableParameters(parameterSelectPercent);
+    nextSelectIncrementTime = millis() + round(PID_SLEWING_TO_TRACKING_TIME_MS/100.0F);
+  }
+}
+
 // manage feedback, variable PID params
 void DualPid::variableParameters(float percent) {
   float s = percent/sensitivity;
@@ -60,18 +60,16 @@ class DualPid : public Feedback {
     // variable feedback, variable PID params
     void variableParameters(float percent);
 
-    inline void poll() {
-      pid->Compute();
-
-      if (manuallySwitchParameters) {
-        if ((long)(millis() - nextSelectIncrementTime) > 0) {
-          if (trackingSelected) parameterSelectPercent--;
-          if (parameterSelectPercent < 0) parameterSelectPercent = 0;
-          variableParameters(parameterSelectPercent);
-          nextSelectIncrementTime = millis() + round(PID_SLEWING_TO_TRACKING_TIME_MS/100.0F);
-        }
-      }
-    }
+    // compute on every poll() with a sample time of periodUs
+    void setFixedRate(unsigned long periodUs);
+
+    // Tyreus-Luyben gains for tracking and Ziegler-Nichols gains for slewing
+    bool applyTuning(float ultimateGain, float ultimatePeriod);
+
+    inline void poll() { pid->Compute(); }
+
+    // ramp from the slewing to the tracking parameters
+    void pollParameters();
 
   private:
     QuickPID *pid;
@@ -3,3 +3,4 @@
 #pragma once
 
 #include "DualPid/DualPid.h"
+#include "Cascade/Cascade.h"
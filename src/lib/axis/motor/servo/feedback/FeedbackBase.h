@@ -39,6 +39,8 @@ typedef struct ServoControl {
   float in;
   float out;
   float set;
+  float velocityIn;   // measured encoder velocity, in counts per second
+  float velocitySet;  // commanded velocity, in counts per second
   volatile int8_t directionHint;
 } ServoControl;
 
@@ -71,14 +73,34 @@ class Feedback {
     // set feedback control range controlRange, +/- the maximum encoder counts/s
     virtual void setControlRange(float controlRange);
 
+    // the caller runs poll() at a fixed rate, each call is one sample of periodUs
+    virtual void setFixedRate(unsigned long periodUs) { UNUSED(periodUs); }
+
     virtual void poll();
 
+    // step any change of the parameters over time, called from the motor's poll() never the control loop
+    virtual void pollParameters() {}
+
+    // set the gains from a relay test, ultimateGain in counts/s per count of error and ultimatePeriod in seconds
+    // \returns true if the gains were set
+    virtual bool applyTuning(float ultimateGain, float ultimatePeriod) { UNUSED(ultimateGain); UNUSED(ultimatePeriod); return false; }
+
     bool manuallySwitchParameters = true;
 
+    // true if the feedback output already includes the commanded velocity
+    bool feedForward = false;
+
     // true if the feedback instance is ready to use
     bool ready = false;
 
   protected:
+    // set a parameter to a tuned value, it's also saved to NV by the axis
+    void setTuned(AxisParameter *parameter, float value) {
+      value = constrain(value, parameter->min, parameter->max);
+      parameter->value = value;
+      parameter->valueNv = value;
+    }
+
     uint8_t axisNumber = 0;
 
     ServoControl *control;
@@ -36,6 +36,15 @@ class Filter {
   public:
     virtual long update(long encoderCounts, long motorCounts, bool isTracking) { UNUSED(motorCounts); UNUSED(isTracking); return encoderCounts; }
 
+    // commanded velocity for the next update(), in counts per second
+    virtual void setCommandedVelocity(float velocity) { UNUSED(velocity); }
+
+    // velocity estimate from the last update(), in counts per second or NAN if the filter doesn't make one
+    virtual float velocity() { return NAN; }
+
+    // true if update() doesn't allocate, start tasks, or block so it can be called from a timer ISR
+    virtual bool isrSafe() { return true; }
+
   private:
     bool initialized = false;
 };
@@ -8,22 +8,64 @@
     AXIS7_SERVO_FLTR == KALMAN || AXIS8_SERVO_FLTR == KALMAN || AXIS9_SERVO_FLTR == KALMAN
 
 KalmanFilter::KalmanFilter(float measurementUncertainty, float variance) {
-  kalmanFilter = new SimpleKalmanFilter(measurementUncertainty, measurementUncertainty, variance);
+  measurementVariance = measurementUncertainty;
+  processVariance = variance;
 }
 
-long KalmanFilter::update(long encoderCounts, long motorCounts, bool isTracking) {
+IRAM_ATTR long KalmanFilter::update(long encoderCounts, long motorCounts, bool isTracking) {
   UNUSED(isTracking);
 
-  long delta = encoderCounts - motorCounts;
+  const unsigned long now = micros();
+  float measured = encoderCounts - motorCounts;
 
   if (!initialized) {
-    result = encoderCounts - motorCounts;
+    delta = measured;
+    deltaRate = 0.0F;
+    p00 = measurementVariance;
+    p01 = 0.0F;
+    p11 = measurementVariance;
+    lastUs = now;
+    lastVelocitySet = velocitySet;
+    velocityEstimate = velocitySet;
     initialized = true;
-  } else {
-    result = kalmanFilter->updateEstimate(delta);
+    return encoderCounts;
   }
 
-  return result + motorCounts;
+  float dt = (now - lastUs)/1000000.0F;
+  lastUs = now;
+  if (dt < 0.00001F) dt = 0.00001F; else if (dt > 0.1F) dt = 0.1F;
+
+  // predict, a step in the commanded velocity is a step the other way in the rate of the difference
+  // since the encoder can't follow it instantly, how much it does follow is uncertain
+  float step = velocitySet - lastVelocitySet;
+  lastVelocitySet = velocitySet;
+
+  delta += deltaRate*dt;
+  deltaRate -= step;
+
+  // the faster the commanded motion the less the constant velocity model holds
+  float q = processVariance*(1.0F + fabsf(velocitySet)*KALMAN_MOTION_SCALE);
+  float dt2 = dt*dt;
+  p00 += dt*(2.0F*p01 + dt*p11) + q*dt2*dt/3.0F;
+  p01 += dt*p11 + q*dt2/2.0F;
+  p11 += q*dt + step*step;
+
+  // correct
+  float innovation = measured - delta;
+  float s = p00 + measurementVariance;
+  float k0 = p00/s;
+  float k1 = p01/s;
+
+  delta += k0*innovation;
+  deltaRate += k1*innovation;
+
+  p11 -= k1*p01;
+  p00 -= k0*p00;
+  p01 -= k0*p01;
+
+  velocityEstimate = deltaRate + velocitySet;
+
+  return motorCounts + lroundf(delta);
 }
 
 #endif
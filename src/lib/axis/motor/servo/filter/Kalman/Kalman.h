@@ -8,19 +8,43 @@
     AXIS4_SERVO_FLTR == KALMAN || AXIS5_SERVO_FLTR == KALMAN || AXIS6_SERVO_FLTR == KALMAN || \
     AXIS7_SERVO_FLTR == KALMAN || AXIS8_SERVO_FLTR == KALMAN || AXIS9_SERVO_FLTR == KALMAN
 
-#include <SimpleKalmanFilter.h> // https://github.com/denyssene/SimpleKalmanFilter
+#ifndef KALMAN_MOTION_SCALE
+  #define KALMAN_MOTION_SCALE 0.01F // process noise grows by this fraction per count/s of commanded velocity
+#endif
 
+// two state (position, velocity) filter of the encoder position less the motor (target) position, so
+// large counts don't lose float precision and the commanded motion is already taken out
 class KalmanFilter : public Filter {
   public:
+    // \param measurementUncertainty: encoder measurement variance, in counts squared
+    // \param variance: process (acceleration) noise, in counts squared per second cubed
     KalmanFilter(float measurementUncertainty, float variance);
 
     long update(long encoderCounts, long motorCounts, bool isTracking);
 
+    void setCommandedVelocity(float velocity) { velocitySet = velocity; }
+
+    float velocity() { return velocityEstimate; }
+
   private:
+    float measurementVariance;
+    float processVariance;
+
     bool initialized = false;
-    long long result;
- 
-    SimpleKalmanFilter *kalmanFilter;
+    unsigned long lastUs = 0;
+
+    float velocitySet = 0.0F;
+    float lastVelocitySet = 0.0F;
+    float velocityEstimate = NAN;
+
+    // state, encoder less motor position and its rate
+    float delta = 0.0F;
+    float deltaRate = 0.0F;
+
+    // covariance, symmetric
+    float p00 = 0.0F;
+    float p01 = 0.0F;
+    float p11 = 0.0F;
 };
 
 #endif
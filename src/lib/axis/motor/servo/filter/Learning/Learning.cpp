@@ -2,197 +2,212 @@
 // learning filter (experimental)
 //
 // This is not a conventional noise filter.
-// It attempts to learn a repeatable cosine-like periodic error in the
-// encoder-minus-motor delta for the RA axis and subtract part of that learned
-// pattern back out. It should be treated as experimental cyclic-error
-// compensation rather than a general-purpose smoothing filter.
+// It learns the repeatable part of the encoder-minus-motor error at up to three
+// known mechanical periods (worm, spur gear, belt, etc.) and feeds a correction
+// forward so the servo works it out.  It should be treated as experimental
+// periodic error compensation rather than a general-purpose smoothing filter.
 
 #include "Learning.h"
 
-#if AXIS1_SERVO_FLTR == LEARNING
-
-#include "../../../../tasks/OnTask.h"
-
-void learningAnalyze() { filterAxis1.analyze(); }
-
-LearningFilter::LearningFilter(int smoothingWindowSize, int historyLength) {
-  this->smoothingWindowSize = smoothingWindowSize;
-  this->historyLength = historyLength;
-
-  deltaSamples = new long[this->historyLength];
-
-  if (deltaSamples == NULL) { active = false; return; } else active = true;
-
-  trackingCountsPerSecond = (AXIS1_COUNTS_PER_DEGREE/240.0F)*SIDEREAL_RATIO_F;
-  sampleSpacingCounts = trackingCountsPerSecond/4.0F;
-  sampleSpacingSeconds = sampleSpacingCounts/trackingCountsPerSecond;
-}
-
-long LearningFilter::wrappedSampleIndex(long sample) const {
-  long wrapped = sample % historyLength;
-  if (wrapped < 0) wrapped += historyLength;
-  return wrapped;
-}
-
-float LearningFilter::periodicCorrection(long sample) const {
-  if (!lock || averagePeriodSamples <= 0.0F) return 0.0F;
+#if AXIS1_SERVO_FLTR == LEARNING || AXIS2_SERVO_FLTR == LEARNING || AXIS3_SERVO_FLTR == LEARNING || \
+    AXIS4_SERVO_FLTR == LEARNING || AXIS5_SERVO_FLTR == LEARNING || AXIS6_SERVO_FLTR == LEARNING || \
+    AXIS7_SERVO_FLTR == LEARNING || AXIS8_SERVO_FLTR == LEARNING || AXIS9_SERVO_FLTR == LEARNING
+
+#include "../../../../../tasks/OnTask.h"
+#include "../../../../../nv/Nv.h"
+
+// largest correction held in a table, in counts (fits the NV record)
+#define LEARNING_CORRECTION_MAX 4000.0F
+
+static LearningFilter *learningFilterInstance[9];
+void learningAnalyzeAxis1() { learningFilterInstance[0]->analyze(); }
+void learningAnalyzeAxis2() { learningFilterInstance[1]->analyze(); }
+void learningAnalyzeAxis3() { learningFilterInstance[2]->analyze(); }
+void learningAnalyzeAxis4() { learningFilterInstance[3]->analyze(); }
+void learningAnalyzeAxis5() { learningFilterInstance[4]->analyze(); }
+void learningAnalyzeAxis6() { learningFilterInstance[5]->analyze(); }
+void learningAnalyzeAxis7() { learningFilterInstance[6]->analyze(); }
+void learningAnalyzeAxis8() { learningFilterInstance[7]->analyze(); }
+void learningAnalyzeAxis9() { learningFilterInstance[8]->analyze(); }
+
+LearningFilter::LearningFilter(uint8_t axisNumber, int smoothingWindowSize, double period1, double period2, double period3) {
+  if (axisNumber < 1 || axisNumber > 9) return;
+
+  this->axisNumber = axisNumber;
+  this->smoothingWindowSize = smoothingWindowSize < 1 ? 1 : smoothingWindowSize;
+
+  // a period must span at least one count per bin
+  const double periodList[LEARNING_PERIODS] = {period1, period2, period3};
+  for (int i = 0; i < LEARNING_PERIODS; i++) {
+    if (periodList[i] >= LEARNING_BINS) period[periods++] = periodList[i];
+  }
+  if (periods == 0) return;
 
-  float phaseOffset = fmodf((sample - averagePhaseSample), averagePeriodSamples);
-  if (phaseOffset < 0.0F) phaseOffset += averagePeriodSamples;
+  learningFilterInstance[axisNumber - 1] = this;
+  reset();
 
-  return cosf((phaseOffset/averagePeriodSamples)*PI*2.0F) * (averageAmplitude*0.4F);
+  active = true;
 }
 
 long LearningFilter::update(long encoderCounts, long motorCounts, bool learningActive) {
   if (!active) return encoderCounts;
 
-  long delta = encoderCounts - motorCounts;
+  float delta = encoderCounts - motorCounts;
 
   if (!initialized) {
-    reset();
-
     smoothedDelta = delta;
-    smoothedEncoderCounts = encoderCounts;
 
-    VF("MSG: Filter, learning start polling task (rate 5s priority 7)... ");
-    if (tasks.add(2000, 0, true, 7, learningAnalyze, "Learn")) { VLF("success"); } else { VLF("FAILED!"); }
+    VF("MSG: Axis"); V(axisNumber); VF(", filter learning start analysis task (rate 2s priority 7)... ");
+    char taskName[] = "Ax_Lrn";
+    taskName[2] = '0' + axisNumber;
+    void (*callback)() = NULL;
+    switch (axisNumber) {
+      case 1: callback = learningAnalyzeAxis1; break;
+      case 2: callback = learningAnalyzeAxis2; break;
+      case 3: callback = learningAnalyzeAxis3; break;
+      case 4: callback = learningAnalyzeAxis4; break;
+      case 5: callback = learningAnalyzeAxis5; break;
+      case 6: callback = learningAnalyzeAxis6; break;
+      case 7: callback = learningAnalyzeAxis7; break;
+      case 8: callback = learningAnalyzeAxis8; break;
+      case 9: callback = learningAnalyzeAxis9; break;
+    }
+    if (tasks.add(2000, 0, true, 7, callback, taskName)) { VLF("success"); } else { VLF("FAILED!"); }
 
     initialized = true;
   }
 
-  smoothedDelta = (smoothedDelta*(smoothingWindowSize - 1) + delta)/smoothingWindowSize;
-  smoothedEncoderCounts = (smoothedEncoderCounts*(smoothingWindowSize - 1) + encoderCounts)/smoothingWindowSize;
-
-  sampleIndex = lround(smoothedEncoderCounts/sampleSpacingCounts);
-
-  // Take samples only while the motion is stable enough to learn from.
-  if (learningActive && sampleIndex != lastLearnedSampleIndex) {
-    lastLearnedSampleIndex = sampleIndex;
+  smoothedDelta += (delta - smoothedDelta)/smoothingWindowSize;
+
+  float correction = 0.0F;
+  for (int k = 0; k < periods; k++) {
+    // position within the period, in bins, reduced to one period in double so a 24 to 26 bit count keeps its low bits
+    double phase = fmod((double)encoderCounts, period[k]);
+    if (phase < 0.0) phase += period[k];
+    float binPosition = (float)(phase*(LEARNING_BINS/period[k]));
+    int bin = (int)binPosition;
+    if (bin < 0) bin = 0; else if (bin >= LEARNING_BINS) bin = LEARNING_BINS - 1;
+
+    // corrections are for the bin centers, interpolate toward the nearer neighbor
+    float offset = binPosition - (bin + 0.5F);
+    int neighbor = offset >= 0.0F ? bin + 1 : bin - 1;
+    if (neighbor >= LEARNING_BINS) neighbor = 0; else if (neighbor < 0) neighbor = LEARNING_BINS - 1;
+    correction += table[k][bin] + (table[k][neighbor] - table[k][bin])*fabsf(offset);
+
+    // on leaving a bin that was learned over its whole pass, move its correction toward the error seen there
+    if (bin != currentBin[k]) {
+      if (errorSamples[k] > 0) {
+        float binError = errorSum[k]/errorSamples[k];
+        int last = currentBin[k];
+
+        if (isnan(meanError[k])) meanError[k] = binError; else meanError[k] += (binError - meanError[k])/LEARNING_BINS;
+
+        table[k][last] += (LEARNING_RATE/periods)*(binError - meanError[k]);
+        if (table[k][last] > LEARNING_CORRECTION_MAX) table[k][last] = LEARNING_CORRECTION_MAX; else
+        if (table[k][last] < -LEARNING_CORRECTION_MAX) table[k][last] = -LEARNING_CORRECTION_MAX;
+
+        if (passes[k][last] < 255) passes[k][last]++;
+        changed = true;
+      }
+
+      currentBin[k] = bin;
+      errorSum[k] = 0.0F;
+      errorSamples[k] = 0;
+    }
 
-    deltaSamples[wrappedSampleIndex(sampleIndex)] = smoothedDelta;
+    // a pass that isn't learned from start to end is skipped
+    if (learningActive && errorSamples[k] >= 0) {
+      errorSum[k] += smoothedDelta;
+      errorSamples[k]++;
+    } else errorSamples[k] = -1;
   }
 
-  learnedCorrection = lroundf(periodicCorrection(sampleIndex));
-
-  return (smoothedDelta - learnedCorrection) + motorCounts;
+  return lroundf(smoothedDelta + correction) + motorCounts;
 }
 
 void LearningFilter::analyze() {
   if (!active) return;
 
-  // Find the strongest positive and negative error sample in the learned history.
-  long maxDelta = deltaSamples[wrappedSampleIndex(sampleIndex)];
-  long minDelta = maxDelta;
-  long strongestPhaseSample = wrappedSampleIndex(sampleIndex);
-  for (int i = 0; i < historyLength; i++) {
-    int j = wrappedSampleIndex(sampleIndex - i);
-    if (deltaSamples[j] >= maxDelta) { maxDelta = deltaSamples[j]; strongestPhaseSample = j; }
-    if (deltaSamples[j] <= minDelta) { minDelta = deltaSamples[j]; }
-    Y;
+  if (!loaded) {
+    load();
+    loaded = true;
+    lastSaveTime = millis();
   }
-  phaseSample = strongestPhaseSample;
-
-  averagePeakDelta = ((averagePeakDelta*19.0F) + maxDelta)/20.0F;
-  averageValleyDelta = ((averageValleyDelta*19.0F) + minDelta)/20.0F;
-  averageAmplitude = (averagePeakDelta - averageValleyDelta)/2.0F;
-
-  float error;
-  float sampleDelta;
-  error = 0;
-  for (int i = 0; i < historyLength; i++) {
-    int j = wrappedSampleIndex(phaseSample - i);
-    sampleDelta = deltaSamples[j];
-    error += sampleDelta*sampleDelta;
-    Y;
+
+  // the steady part of the error is for the feedback to deal with, keep each table centered on zero
+  for (int k = 0; k < periods; k++) {
+    float mean = 0.0F;
+    for (int i = 0; i < LEARNING_BINS; i++) mean += table[k][i];
+    mean /= LEARNING_BINS;
+    for (int i = 0; i < LEARNING_BINS; i++) table[k][i] -= mean;
   }
-  error /= historyLength;
-  float nativeError = error;
-
-  float bestError = 100000;
-  float bestPeriod = 0;
-  for (int period = 200; period > 20; period -= 1) {
-    error = 0;
-    for (int i = 0; i < historyLength; i++) {
-      int j = wrappedSampleIndex(phaseSample - i);
-      sampleDelta = deltaSamples[j] - cosf(((i/(float)historyLength)*(period/20.0F))*(float)(PI)*2.0F)*averageAmplitude;
-      error += sampleDelta*sampleDelta;
-      Y;
-    }
-    error /= historyLength;
 
-    if (error < bestError) {
-      bestPeriod = historyLength/(period/20.0F);
-      bestError = error;
+  if (changed && (long)(millis() - lastSaveTime) >= LEARNING_SAVE_MINUTES*60000L) {
+    save();
+    lastSaveTime = millis();
+  }
+}
+
+void LearningFilter::reset() {
+  for (int k = 0; k < periods; k++) {
+    for (int i = 0; i < LEARNING_BINS; i++) {
+      table[k][i] = 0.0F;
+      passes[k][i] = 0;
     }
+    currentBin[k] = -1;
+    errorSum[k] = 0.0F;
+    errorSamples[k] = -1;
+    meanError[k] = NAN;
   }
+  changed = false;
+}
 
-  if (averagePhaseSample == 0) {
-    averagePhaseSample = phaseSample;
-  } else {
-    float phaseForAverage = (float)phaseSample;
-    float avgPhaseForAverage = (float)averagePhaseSample;
+void LearningFilter::load() {
+  for (int k = 0; k < periods; k++) {
+    char keyStr[26];
+    snprintf(keyStr, sizeof(keyStr), "AXIS%u_LEARN%u", (unsigned)axisNumber, (unsigned)(k + 1));
 
-    // Smooth phase on a circular history buffer without jumping at wraparound.
-    if (labs(phaseSample - averagePhaseSample) > historyLength/2) {
-      if (phaseSample < averagePhaseSample) phaseForAverage += historyLength; else avgPhaseForAverage += historyLength;
+    LearningTableNv stored;
+    if (nv().kv().get(nv().kv().computeKey(keyStr), stored) != KvPartition::Status::Ok) continue;
+
+    if (fabs(stored.period - period[k]) > period[k]*0.0001) {
+      VF("MSG: Axis"); V(axisNumber); VF(", filter learning period"); V(k + 1); VLF(" changed, ignoring the table on NV");
+      continue;
     }
 
-    averagePhaseSample = wrappedSampleIndex(lroundf((avgPhaseForAverage*19.0F + phaseForAverage)/20.0F));
-  }
-  if (averagePeriodSamples == 0) averagePeriodSamples = bestPeriod;
-  averagePeriodSamples = ((averagePeriodSamples*19.0F) + bestPeriod)/20.0F;
-
-  long phaseDistance = labs(phaseSample - averagePhaseSample);
-  if (phaseDistance > historyLength/2) phaseDistance = historyLength - phaseDistance;
-  const long phaseTolerance = max(2L, lroundf(averagePeriodSamples*0.1F));
-
-  if (bestError < nativeError &&
-      averagePeriodSamples > 0 &&
-      bestPeriod/averagePeriodSamples > 0.8F && bestPeriod/averagePeriodSamples < 1.2F &&
-      phaseDistance <= phaseTolerance)
-  {
-    lock = true; 
-  } else {
-    lock = false;
+    for (int i = 0; i < LEARNING_BINS; i++) {
+      table[k][i] = stored.bin[i]/8.0F;
+      passes[k][i] = LEARNING_MIN_PASSES;
+    }
+    VF("MSG: Axis"); V(axisNumber); VF(", filter learning period"); V(k + 1); VLF(" table read from NV");
   }
-
-  if (lock) { D("Lock: true "); } else { D("Lock: false"); }
-  D(", Qual: "); D((bestError > 0.0F) ? sqrtf(nativeError/bestError)*100.0F : 0.0F); D("%");
-  D(", Period s: "); D(bestPeriod*sampleSpacingSeconds); D(", Period avg s: "); D(averagePeriodSamples*sampleSpacingSeconds);
-  D(", Phase: "); D((averagePeriodSamples > 0.0F) ? fmodf((float)phaseSample, averagePeriodSamples)/averagePeriodSamples : 0.0F);
-  D(", Phase avg: "); DL((averagePeriodSamples > 0.0F) ? fmodf((float)averagePhaseSample, averagePeriodSamples)/averagePeriodSamples : 0.0F);
-
-
-//  VF("MSG: Native error (sd)      "); VL(sqrt(nativeError));
-//  VF("MSG: Best error             "); VL(sqrt(bestError));
-//  VF("MSG: Default frame (samples)"); VL(historyLength);
-//  VF("MSG: B Period (samples)     "); VL(bestPeriod);
-//  VF("MSG: A Period (samples)     "); VL(averagePeriodSamples);
-//  VF("MSG: Phase (samples)        "); VL(averagePhaseSample);
-//  VF("MSG: Phase cos()            "); VL(cos((averagePhaseSample/averagePeriodSamples)*PI*2.0F));
-//  VF("MSG: Amplitude (counts)     "); VL(averageAmplitude);
-//  VL("");
-  
 }
 
-void LearningFilter::reset() {
-  if (!active) return;
+void LearningFilter::save() {
+  for (int k = 0; k < periods; k++) {
+    // only tables learned all the way around are worth keeping
+    float minimum = table[k][0];
+    float maximum = table[k][0];
+    bool trained = true;
+    for (int i = 0; i < LEARNING_BINS; i++) {
+      if (passes[k][i] < LEARNING_MIN_PASSES) { trained = false; break; }
+      if (table[k][i] < minimum) minimum = table[k][i];
+      if (table[k][i] > maximum) maximum = table[k][i];
+    }
+    if (!trained) continue;
+
+    LearningTableNv stored;
+    stored.period = (float)period[k];
+    for (int i = 0; i < LEARNING_BINS; i++) stored.bin[i] = lroundf(table[k][i]*8.0F);
 
-  phaseSample = 0;
-  averagePhaseSample = 0;
-  learnedCorrection = 0;
-  averagePeakDelta = 0;
-  averageValleyDelta = 0;
-  averageAmplitude = 0;
-  averagePeriodSamples = 0;
-  sampleIndex = 0;
-  lastLearnedSampleIndex = 0;
-  lock = false;
-  for (int i = 0; i < historyLength; i++) {
-    deltaSamples[i] = 0;
+    char keyStr[26];
+    snprintf(keyStr, sizeof(keyStr), "AXIS%u_LEARN%u", (unsigned)axisNumber, (unsigned)(k + 1));
+    nv().kv().put(nv().kv().computeKey(keyStr), stored);
+
+    VF("MSG: Axis"); V(axisNumber); VF(", filter learning period"); V(k + 1);
+    VF(" table saved, amplitude "); V((maximum - minimum)/2.0F); VLF(" counts");
   }
+  changed = false;
 }
 
-LearningFilter filterAxis1(AXIS1_SERVO_FLTR_WSIZE, 240);
-
 #endif
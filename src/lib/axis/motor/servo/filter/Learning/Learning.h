@@ -4,48 +4,84 @@
 
 #include "../FilterBase.h"
 
-#if AXIS1_SERVO_FLTR == LEARNING
+#if AXIS1_SERVO_FLTR == LEARNING || AXIS2_SERVO_FLTR == LEARNING || AXIS3_SERVO_FLTR == LEARNING || \
+    AXIS4_SERVO_FLTR == LEARNING || AXIS5_SERVO_FLTR == LEARNING || AXIS6_SERVO_FLTR == LEARNING || \
+    AXIS7_SERVO_FLTR == LEARNING || AXIS8_SERVO_FLTR == LEARNING || AXIS9_SERVO_FLTR == LEARNING
 
+#define LEARNING_PERIODS 3                 // known periods learned at once per axis
+#define LEARNING_BINS 64                   // phase bins per period, fixed as it sets the NV record layout
+
+#ifndef LEARNING_RATE
+  #define LEARNING_RATE 0.25F              // fraction of a bin's remaining error learned on each pass
+#endif
+#ifndef LEARNING_MIN_PASSES
+  #define LEARNING_MIN_PASSES 2            // passes over every bin of a period before its table is saved
+#endif
+#ifndef LEARNING_SAVE_MINUTES
+  #define LEARNING_SAVE_MINUTES 30         // minutes between saving the learned tables to NV
+#endif
+
+#pragma pack(1)
+// learned table for one period as kept in NV, 132 bytes
+typedef struct LearningTableNv {
+  float period;                            // in encoder counts, a table for another period isn't used
+  int16_t bin[LEARNING_BINS];              // correction in 1/8 counts
+} LearningTableNv;
+#pragma pack()
+
+// periodic error compensation for known mechanical periods (worm, spur gear, belt, etc.)
+//
+// Each period has a table of corrections indexed by the phase of the encoder position within that period.
+// While learning, the encoder less motor error in each bin is added (in part) to that bin's correction on
+// every pass, and the interpolated sum of the corrections is added to the encoder position reported to the
+// feedback so the servo works the repeatable part of the error out.  The tables persist in NV so this
+// depends on the encoder position being the same at a given point in the gear train after a restart
+// (absolute encoders, or incremental encoders that are homed or parked consistently.)
 class LearningFilter : public Filter {
   public:
-    // smoothingWindowSize: sample count for the rolling average
-    // historyLength: number of learned samples retained for periodic analysis
-    // learningActive: true when the motion is stable enough to train on
-    LearningFilter(int smoothingWindowSize, int historyLength);
+    // \param axisNumber: the axis this filter is used on, 1 to 9
+    // \param smoothingWindowSize: sample count for the rolling average
+    // \param period1: first period, in encoder counts of axis travel
+    // \param period2: second period, in encoder counts or 0 if unused
+    // \param period3: third period, in encoder counts or 0 if unused
+    LearningFilter(uint8_t axisNumber, int smoothingWindowSize, double period1, double period2, double period3);
 
+    // \param learningActive: true when the motion is steady enough to train on
     long update(long encoderCounts, long motorCounts, bool learningActive);
 
+    // remove each table's mean, report, and load/save the tables in NV
     void analyze();
 
+    // forget everything learned since the tables were last loaded or cleared
     void reset();
 
+    // the first update starts the analysis task
+    bool isrSafe() { return false; }
+
   private:
-    long wrappedSampleIndex(long sample) const;
-    float periodicCorrection(long sample) const;
+    void load();
+    void save();
 
+    uint8_t axisNumber;
     bool active = false;
     bool initialized = false;
-    bool lock = false;
-    int smoothingWindowSize; // in samples
-    int historyLength;       // in samples
-
-    float trackingCountsPerSecond;
-    float sampleSpacingCounts;
-    float sampleSpacingSeconds;
-    long phaseSample = 0;
-    long averagePhaseSample = 0;
-    long learnedCorrection = 0;
-    float averagePeakDelta = 0;
-    float averageValleyDelta = 0;
-    float averageAmplitude = 0;
-    float averagePeriodSamples = 0;
-    long *deltaSamples;
-    long sampleIndex = 0;
-    long long smoothedDelta;
-    long long smoothedEncoderCounts;
-    long lastLearnedSampleIndex = 0;
-};
+    bool loaded = false;
+    int smoothingWindowSize;               // in samples
+    float smoothedDelta = 0.0F;            // encoder less motor, counts
+
+    uint8_t periods = 0;                   // number of periods in use
+    double period[LEARNING_PERIODS];       // in encoder counts
+    float table[LEARNING_PERIODS][LEARNING_BINS];
+    uint8_t passes[LEARNING_PERIODS][LEARNING_BINS];
 
-extern LearningFilter filterAxis1;
+    // the bin currently being passed over for each period and the error summed there
+    int currentBin[LEARNING_PERIODS];
+    float errorSum[LEARNING_PERIODS];
+    int errorSamples[LEARNING_PERIODS];
+    float meanError[LEARNING_PERIODS];     // steady lag over about one period, left to the feedback
+
+    bool changed = false;                  // learned since the tables were last saved
+    unsigned long lastSaveTime = 0;
+};
 
 #endif
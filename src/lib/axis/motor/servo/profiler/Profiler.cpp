@@ -0,0 +1,144 @@
+// -----------------------------------------------------------------------------------
+// axis servo motor, control loop cost and tracking error statistics
+
+#include "Profiler.h"
+
+#if defined(SERVO_MOTOR_PRESENT) && SERVO_PROFILER == ON
+
+#include "../../../../convert/Convert.h"
+
+IRAM_ATTR void ServoProfiler::sample(uint32_t t0, long error, float velocitySet) {
+  uint32_t ticks = HAL_FAST_TICKS() - t0;
+  if (ticks < cost.min) cost.min = ticks;
+  if (ticks > cost.max) cost.max = ticks;
+  cost.total += ticks;
+  cost.count++;
+
+  const unsigned long now = micros();
+  uint32_t errorMagnitude = labs(error);
+
+  tracking.samples++;
+  tracking.sumSquares += (float)error*(float)error;
+  if (errorMagnitude > tracking.peak) tracking.peak = errorMagnitude;
+
+  // a step in the commanded velocity (re)starts the settling time, slews ramp so they settle from the end of the ramp
+  if (fabsf(velocitySet - lastVelocitySet) > fabsf(lastVelocitySet)*0.1F + 1.0F) {
+    settling = true;
+    inBand = false;
+    stepUs = now;
+  }
+  lastVelocitySet = velocitySet;
+
+  if (settling) {
+    if (errorMagnitude <= SERVO_PROFILER_SETTLE_BAND) {
+      if (!inBand) { inBand = true; inBandUs = now; } else
+      if ((long)(now - inBandUs) >= SERVO_PROFILER_SETTLE_HOLD_MS*1000L) {
+        tracking.settleMs = (inBandUs - stepUs)/1000UL;
+        if (tracking.settleMs > tracking.settleMaxMs) tracking.settleMaxMs = tracking.settleMs;
+        tracking.settles++;
+        settling = false;
+      }
+    } else inBand = false;
+  }
+
+  // average the error over each spectrum sample period
+  errorSum += error;
+  errorCount++;
+  if (lastHistoryUs == 0) lastHistoryUs = now;
+  const long periodUs = 1000000L/SERVO_PROFILER_RATE;
+  if ((long)(now - lastHistoryUs) >= periodUs) {
+    history[historyHead] = errorSum/errorCount;
+    historyHead = (historyHead + 1) & (SERVO_PROFILER_SAMPLES - 1);
+    if (historyCount < SERVO_PROFILER_SAMPLES) historyCount++;
+    errorSum = 0.0F;
+    errorCount = 0;
+
+    // keep to the sample grid unless a whole period was missed
+    lastHistoryUs += periodUs;
+    if ((long)(now - lastHistoryUs) >= periodUs) lastHistoryUs = now;
+  }
+}
+
+void ServoProfiler::getCost(char *reply, size_t replySize) {
+  noInterrupts();
+  ServoLoopCost c = cost;
+  cost = {UINT32_MAX, 0, 0, 0};
+  interrupts();
+
+  if (c.count == 0) { snprintf(reply, replySize, "0,0,0"); return; }
+  snprintf(reply, replySize, "%lu,%lu,%lu", (unsigned long)c.min, (unsigned long)(c.total/c.count), (unsigned long)c.max);
+}
+
+void ServoProfiler::getTracking(char *reply, size_t replySize) {
+  noInterrupts();
+  ServoTrackingError t = tracking;
+  tracking = {0, 0.0F, 0, 0, 0, 0};
+  interrupts();
+
+  char rms[16];
+  sprintF(rms, "%0.2f", t.samples == 0 ? 0.0F : sqrtf(t.sumSquares/t.samples));
+  snprintf(reply, replySize, "%lu,%s,%lu,%lu,%lu,%lu", (unsigned long)t.samples, rms, (unsigned long)t.peak,
+                                                        (unsigned long)t.settles, (unsigned long)t.settleMs, (unsigned long)t.settleMaxMs);
+}
+
+void ServoProfiler::getSpectrum(char *reply, size_t replySize) {
+  const int n = SERVO_PROFILER_SAMPLES;
+  float x[SERVO_PROFILER_SAMPLES];
+
+  // oldest sample first
+  noInterrupts();
+  bool full = historyCount >= n;
+  for (int i = 0; i < n; i++) x[i] = history[(historyHead + i) & (n - 1)];
+  interrupts();
+
+  float amplitude[n/2];
+  for (int k = 0; k < n/2; k++) amplitude[k] = 0.0F;
+
+  if (full) {
+    float mean = 0.0F;
+    for (int i = 0; i < n; i++) mean += x[i];
+    mean /= n;
+
+    // Hann window, the amplitude is scaled back by the window sum
+    float windowSum = 0.0F;
+    for (int i = 0; i < n; i++) {
+      float w = 0.5F - 0.5F*cosf((2.0F*PI*i)/(n - 1));
+      x[i] = (x[i] - mean)*w;
+      windowSum += w;
+    }
+
+    // one DFT bin at a time with the twiddle factor rotated in place, no tables needed
+    for (int k = 1; k < n/2; k++) {
+      const float dc = cosf((2.0F*PI*k)/n);
+      const float ds = sinf((2.0F*PI*k)/n);
+      float c = 1.0F, s = 0.0F, re = 0.0F, im = 0.0F;
+      for (int i = 0; i < n; i++) {
+        re += x[i]*c;
+        im -= x[i]*s;
+        float cn = c*dc - s*ds;
+        s = s*dc + c*ds;
+        c = cn;
+      }
+      amplitude[k] = 2.0F*sqrtf(re*re + im*im)/windowSum;
+    }
+  }
+
+  const float binHz = (float)SERVO_PROFILER_RATE/n;
+  int peak = 1;
+  for (int k = 2; k < n/2; k++) if (amplitude[k] > amplitude[peak]) peak = k;
+
+  char temp[16];
+  reply[0] = 0;
+  sprintF(temp, "%0.3f,", binHz); strncat(reply, temp, replySize - strlen(reply) - 1);
+  sprintF(temp, "%0.2f,", peak*binHz); strncat(reply, temp, replySize - strlen(reply) - 1);
+  sprintF(temp, "%0.1f", amplitude[peak]); strncat(reply, temp, replySize - strlen(reply) - 1);
+
+  // octave bands of bins 1, 2-3, 4-7, ... as the root sum square of their amplitudes
+  for (int b = 0; b < SERVO_PROFILER_BANDS; b++) {
+    float sum = 0.0F;
+    for (int k = 1 << b; k < (2 << b) && k < n/2; k++) sum += amplitude[k]*amplitude[k];
+    sprintF(temp, ",%0.1f", sqrtf(sum)); strncat(reply, temp, replySize - strlen(reply) - 1);
+  }
+}
+
+#endif
@@ -0,0 +1,82 @@
+// -----------------------------------------------------------------------------------
+// axis servo motor, control loop cost and tracking error statistics
+#pragma once
+
+#include "../../../../../Common.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+#ifndef SERVO_PROFILER
+  #define SERVO_PROFILER OFF
+#endif
+
+#if SERVO_PROFILER == ON
+
+#ifndef SERVO_PROFILER_SETTLE_BAND
+  #define SERVO_PROFILER_SETTLE_BAND 10      // settled once the tracking error stays within +/- this many counts
+#endif
+#ifndef SERVO_PROFILER_SETTLE_HOLD_MS
+  #define SERVO_PROFILER_SETTLE_HOLD_MS 500  // for this long
+#endif
+#ifndef SERVO_PROFILER_RATE
+  #define SERVO_PROFILER_RATE 50             // tracking error spectrum sample rate, in Hz
+#endif
+
+#define SERVO_PROFILER_SAMPLES 128           // tracking error spectrum window, a power of two
+#define SERVO_PROFILER_BANDS 6               // octave bands reported, the last ends at half the sample rate
+
+typedef struct ServoLoopCost {
+  uint32_t min;
+  uint32_t max;
+  uint32_t count;
+  uint64_t total;
+} ServoLoopCost;
+
+typedef struct ServoTrackingError {
+  uint32_t samples;
+  float sumSquares;    // in counts squared
+  uint32_t peak;       // in counts
+  uint32_t settleMs;   // most recent settling time
+  uint32_t settleMaxMs;
+  uint32_t settles;    // number of settling times measured
+} ServoTrackingError;
+
+class ServoProfiler {
+  public:
+    // record one control loop sample started at t0 (in fast ticks)
+    // \param error: the tracking error in counts
+    // \param velocitySet: the commanded velocity in counts per second, a step change starts a settling time
+    void sample(uint32_t t0, long error, float velocitySet);
+
+    // control loop cost as min,avg,max in fast ticks since the last call
+    void getCost(char *reply, size_t replySize);
+
+    // tracking error as samples,rms,peak (in counts),settle count,last and worst settling time (in ms) since the last call
+    void getTracking(char *reply, size_t replySize);
+
+    // tracking error spectrum over the last SERVO_PROFILER_SAMPLES/SERVO_PROFILER_RATE seconds as
+    // bin width (Hz),peak frequency (Hz),peak amplitude (counts), then the amplitude in each octave band
+    void getSpectrum(char *reply, size_t replySize);
+
+  private:
+    ServoLoopCost cost = {UINT32_MAX, 0, 0, 0};
+    ServoTrackingError tracking = {0, 0.0F, 0, 0, 0, 0};
+
+    float lastVelocitySet = 0.0F;
+    bool settling = false;
+    unsigned long stepUs = 0;
+    unsigned long inBandUs = 0;
+    bool inBand = false;
+
+    // the error averaged over each spectrum sample period
+    float history[SERVO_PROFILER_SAMPLES];
+    uint16_t historyHead = 0;
+    uint16_t historyCount = 0;
+    float errorSum = 0.0F;
+    uint32_t errorCount = 0;
+    unsigned long lastHistoryUs = 0;
+};
+
+#endif
+
+#endif
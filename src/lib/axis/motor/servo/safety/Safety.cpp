@@ -0,0 +1,134 @@
+// -----------------------------------------------------------------------------------
+// axis servo motor, safety monitor
+
+#include "Safety.h"
+
+#if defined(SERVO_MOTOR_PRESENT) && !defined(SERVO_SAFETY_DISABLE)
+
+#include "../../../../convert/Convert.h"
+
+void ServoSafety::setVelocityMax(float velocityMax) {
+  if (velocityMax < 1.0F) velocityMax = 1.0F;
+  followingScale = 1.0F/(velocityMax*(SERVO_SAFETY_FOLLOWING_MS/1000.0F));
+  velocityScale = 1.0F/(velocityMax*(SERVO_SAFETY_VELOCITY/100.0F));
+}
+
+void ServoSafety::reset() {
+  trip = ST_NONE;
+  tripFast = false;
+  lastUs = 0;
+  commandHigh = 0.0F;
+  commandLow = 0.0F;
+  for (int i = 0; i < 4; i++) { fastTime[i] = 0.0F; slowTime[i] = 0.0F; }
+  aboveTime = 1000.0F;
+  belowTime = 1000.0F;
+  recordHead = 0;
+  recordCount = 0;
+  recordTime = 0.0F;
+}
+
+IRAM_ATTR bool ServoSafety::check(long motorCounts, long encoderCounts, float velocityCommand, float velocity, float power, bool closedLoop) {
+  if (trip != ST_NONE) return true;
+
+  const unsigned long nowUs = micros();
+  float dt = lastUs == 0 ? 0.0F : (nowUs - lastUs)/1000000.0F;
+  lastUs = nowUs;
+  if (dt > 0.1F) dt = 0.1F;
+
+  // the band of recently commanded velocities relaxes to the present command, so the axis can coast
+  // down after a stop or lag a reversal without looking like it's running away
+  float relax = dt*(1000.0F/SERVO_SAFETY_SETTLE_MS);
+  if (relax > 1.0F) relax = 1.0F;
+  if (velocityCommand > commandHigh) commandHigh = velocityCommand; else commandHigh += (velocityCommand - commandHigh)*relax;
+  if (velocityCommand < commandLow) commandLow = velocityCommand; else commandLow += (velocityCommand - commandLow)*relax;
+
+  if (closedLoop) {
+    grade(ST_FOLLOWING, labs(motorCounts - encoderCounts)*followingScale, dt, true);
+
+    float excess = 0.0F;
+    if (velocity > commandHigh) excess = velocity - commandHigh; else
+    if (velocity < commandLow) excess = commandLow - velocity;
+    grade(ST_RUNAWAY, excess*velocityScale, dt, true);
+  }
+
+  // a stalled axis isn't going anywhere, so this only has the slow tier
+  const float stallRatio = fabsf(velocity) < SERVO_SAFETY_STALL_VELOCITY ? fabsf(power)*(1.0F/SERVO_SAFETY_STALL_POWER) : 0.0F;
+  grade(ST_STALL, stallRatio, dt, false);
+
+  // power above the stall power both ways within the slow trip time
+  if (power > SERVO_SAFETY_STALL_POWER) aboveTime = 0.0F; else aboveTime += dt;
+  if (power < -SERVO_SAFETY_STALL_POWER) belowTime = 0.0F; else belowTime += dt;
+  if (trip == ST_NONE && aboveTime < SERVO_SAFETY_SLOW_MS/1000.0F && belowTime < SERVO_SAFETY_SLOW_MS/1000.0F) {
+    trip = ST_OSCILLATION;
+    tripFast = false;
+  }
+
+  recordTime += dt;
+  if (recordTime >= SERVO_SAFETY_RECORD_MS/1000.0F || trip != ST_NONE) {
+    recordTime = 0.0F;
+    record(motorCounts, encoderCounts, velocityCommand, velocity, power);
+  }
+
+  return trip != ST_NONE;
+}
+
+// time over an envelope adds up and time within it counts down, so brief excursions don't trip
+IRAM_ATTR void ServoSafety::grade(SafetyTrip reason, float ratio, float dt, bool fastTier) {
+  const int i = reason - 1;
+
+  if (ratio >= 1.0F) slowTime[i] += dt; else if ((slowTime[i] -= dt) < 0.0F) slowTime[i] = 0.0F;
+  if (fastTier) {
+    if (ratio >= SERVO_SAFETY_FAST_RATIO) fastTime[i] += dt; else if ((fastTime[i] -= dt) < 0.0F) fastTime[i] = 0.0F;
+  }
+
+  if (trip != ST_NONE) return;
+  if (fastTier && fastTime[i] >= SERVO_SAFETY_FAST_MS/1000.0F) { trip = reason; tripFast = true; } else
+  if (slowTime[i] >= SERVO_SAFETY_SLOW_MS/1000.0F) { trip = reason; tripFast = false; }
+}
+
+IRAM_ATTR void ServoSafety::record(long motorCounts, long encoderCounts, float velocityCommand, float velocity, float power) {
+  ServoSafetyRecord *r = &records[recordHead];
+  r->timeMs = millis();
+  r->motorCounts = motorCounts;
+  r->encoderCounts = encoderCounts;
+  r->velocityCommand = velocityCommand;
+  r->velocity = velocity;
+  r->power = power;
+
+  recordHead = (recordHead + 1) % SERVO_SAFETY_RECORDS;
+  if (recordCount < SERVO_SAFETY_RECORDS) recordCount++;
+}
+
+const char* ServoSafety::tripName() {
+  switch (trip) {
+    case ST_FOLLOWING: return "following error";
+    case ST_RUNAWAY: return "runaway";
+    case ST_STALL: return "stall";
+    case ST_OSCILLATION: return "oscillation";
+    default: return "none";
+  }
+}
+
+void ServoSafety::getTrip(char *reply) {
+  int tier = 0;
+  if (trip != ST_NONE) tier = tripFast ? 1 : 2;
+  sprintf(reply, "%d,%d", (int)trip, tier);
+}
+
+bool ServoSafety::getRecord(int number, char *reply, size_t replySize) {
+  if (number < 0 || number >= recordCount) return false;
+
+  // records aren't written once tripped, before that this is a snapshot of a moving ring
+  noInterrupts();
+  ServoSafetyRecord r = records[(recordHead + SERVO_SAFETY_RECORDS - 1 - number) % SERVO_SAFETY_RECORDS];
+  interrupts();
+
+  char command[16], velocity[16], power[16];
+  sprintF(command, "%0.1f", r.velocityCommand);
+  sprintF(velocity, "%0.1f", r.velocity);
+  sprintF(power, "%0.1f", r.power);
+  snprintf(reply, replySize, "%lu,%ld,%ld,%s,%s,%s", (unsigned long)r.timeMs, (long)r.motorCounts, (long)r.encoderCounts, command, velocity, power);
+  return true;
+}
+
+#endif
@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------------
+// axis servo motor, safety monitor
+#pragma once
+
+#include "../../../../../Common.h"
+
+#if defined(SERVO_MOTOR_PRESENT) && !defined(SERVO_SAFETY_DISABLE)
+
+#ifndef SERVO_SAFETY_FOLLOWING_MS
+  #define SERVO_SAFETY_FOLLOWING_MS 250    // following error envelope, in ms of motion at the maximum velocity
+#endif
+#ifndef SERVO_SAFETY_VELOCITY
+  #define SERVO_SAFETY_VELOCITY 25         // runaway envelope, moving faster than or against the command by this % of the maximum velocity
+#endif
+#ifndef SERVO_SAFETY_STALL_POWER
+  #define SERVO_SAFETY_STALL_POWER 33      // stall envelope, in % power while not moving, also the oscillation power
+#endif
+#ifndef SERVO_SAFETY_STALL_VELOCITY
+  #define SERVO_SAFETY_STALL_VELOCITY 10   // not moving below this, in counts per second
+#endif
+#ifndef SERVO_SAFETY_FAST_RATIO
+  #define SERVO_SAFETY_FAST_RATIO 2        // an envelope exceeded this many times over is a fast trip
+#endif
+#ifndef SERVO_SAFETY_FAST_MS
+  #define SERVO_SAFETY_FAST_MS 20          // fast trip after this long
+#endif
+#ifndef SERVO_SAFETY_SLOW_MS
+  #define SERVO_SAFETY_SLOW_MS 1000        // slow trip after this long over an envelope
+#endif
+#ifndef SERVO_SAFETY_SETTLE_MS
+  #define SERVO_SAFETY_SETTLE_MS 250       // time allowed to follow a change in the commanded velocity
+#endif
+#ifndef SERVO_SAFETY_RECORD_MS
+  #define SERVO_SAFETY_RECORD_MS 50        // time between records of the state kept for after a trip
+#endif
+
+#define SERVO_SAFETY_RECORDS 16            // records kept, the last is the sample that tripped
+
+enum SafetyTrip {ST_NONE, ST_FOLLOWING, ST_RUNAWAY, ST_STALL, ST_OSCILLATION};
+
+typedef struct ServoSafetyRecord {
+  uint32_t timeMs;
+  int32_t motorCounts;
+  int32_t encoderCounts;
+  float velocityCommand; // in counts per second
+  float velocity;        // in counts per second
+  float power;           // in %
+} ServoSafetyRecord;
+
+// checks every control loop sample against envelopes for the following error, moving faster than (or
+// against) the recently commanded velocity, and power without motion, the time spent over each envelope
+// is leaky so brief excursions don't add up, a large excursion trips fast and a smaller one trips slowly
+class ServoSafety {
+  public:
+    // set the envelopes that scale with the maximum velocity, in counts per second
+    void setVelocityMax(float velocityMax);
+
+    // clear the trip, the time over each envelope and the records
+    void reset();
+
+    // check one control loop sample
+    // \param velocityCommand: the velocity sent to the driver, in counts per second
+    // \param velocity: the encoder velocity, in counts per second
+    // \param power: the motor power, in %
+    // \param closedLoop: false while a test drives the motor so the following error and runaway aren't checked
+    // \returns true once tripped, the motor should be stopped at once
+    bool check(long motorCounts, long encoderCounts, float velocityCommand, float velocity, float power, bool closedLoop);
+
+    inline bool tripped() { return trip != ST_NONE; }
+
+    // the reason for the trip
+    const char* tripName();
+
+    // get the trip as reason (0 none, 1 following error, 2 runaway, 3 stall, 4 oscillation),tier (0 none, 1 fast, 2 slow)
+    void getTrip(char *reply);
+
+    // get a record of the state before the trip, 0 is the latest
+    // \returns false if there is no such record
+    bool getRecord(int number, char *reply, size_t replySize);
+
+    volatile SafetyTrip trip = ST_NONE;
+    bool tripFast = false;
+
+  private:
+    void grade(SafetyTrip reason, float ratio, float dt, bool fastTier);
+    void record(long motorCounts, long encoderCounts, float velocityCommand, float velocity, float power);
+
+    float followingScale = 0.0F;   // per count of following error, 1.0 at the envelope
+    float velocityScale = 0.0F;    // per count per second of runaway
+
+    unsigned long lastUs = 0;
+
+    // the band of recently commanded velocities, in counts per second
+    float commandHigh = 0.0F;
+    float commandLow = 0.0F;
+
+    // time over each envelope, in seconds
+    float fastTime[4] = {0.0F, 0.0F, 0.0F, 0.0F};
+    float slowTime[4] = {0.0F, 0.0F, 0.0F, 0.0F};
+
+    // time since the power was last above +/- SERVO_SAFETY_STALL_POWER, in seconds
+    float aboveTime = 1000.0F;
+    float belowTime = 1000.0F;
+
+    ServoSafetyRecord records[SERVO_SAFETY_RECORDS];
+    uint8_t recordHead = 0;
+    uint8_t recordCount = 0;
+    float recordTime = 0.0F;
+};
+
+#endif
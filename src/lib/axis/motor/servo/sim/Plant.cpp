@@ -0,0 +1,77 @@
+// -----------------------------------------------------------------------------------
+// axis servo simulated DC motor and gear train
+
+#include "Plant.h"
+
+#ifdef SERVO_SIM_PRESENT
+
+IRAM_ATTR void ServoSimPlant::update(float power, float velocityMax) {
+  const unsigned long now = micros();
+  if (lastUpdateUs == 0) { lastUpdateUs = now; return; }
+
+  // a long gap in the caller isn't simulated as one leap
+  float dt = (now - lastUpdateUs)/1000000.0F;
+  lastUpdateUs = now;
+  if (dt > 0.1F) dt = 0.1F;
+
+  if (power > 1.0F) power = 1.0F; else if (power < -1.0F) power = -1.0F;
+
+  // acceleration at full power from standstill, and the friction as a part of it
+  const float tau = SERVO_SIM_TIME_CONSTANT/1000.0F;
+  const float accelerationMax = velocityMax/tau;
+  const float friction = accelerationMax*(SERVO_SIM_FRICTION/100.0F);
+  const float stiction = accelerationMax*(SERVO_SIM_STICTION/100.0F);
+
+  // sub-steps of at most an eighth of the time constant keep the integration stable
+  int steps = (int)ceilf(dt/(tau*0.125F));
+  if (steps < 1) steps = 1; else if (steps > 64) steps = 64;
+  const float h = dt/steps;
+
+  float distance = 0.0F;
+  for (int i = 0; i < steps; i++) {
+    // drive less the back-EMF and viscous losses
+    float acceleration = (power*velocityMax - motorVelocity)/tau;
+
+    if (motorVelocity == 0.0F) {
+      // held until the drive breaks it away
+      if (fabsf(acceleration) <= stiction) continue;
+      motorVelocity = (acceleration - copysignf(friction, acceleration))*h;
+    } else {
+      // friction stops the motor rather than reversing it
+      float velocity = motorVelocity + (acceleration - copysignf(friction, motorVelocity))*h;
+      if ((velocity > 0.0F) != (motorVelocity > 0.0F)) velocity = 0.0F;
+      motorVelocity = velocity;
+    }
+
+    distance += motorVelocity*h;
+  }
+
+  motorFraction += distance;
+  long whole = (long)floorf(motorFraction);
+  motorCounts += whole;
+  motorFraction -= whole;
+
+  // the axis only moves once the motor has taken up the backlash
+  const float backlashHalf = SERVO_SIM_BACKLASH/2.0F;
+  backlashGap += distance;
+  if (backlashGap > backlashHalf) backlashGap = backlashHalf; else
+  if (backlashGap < -backlashHalf) backlashGap = -backlashHalf;
+  float axisFraction = motorFraction - backlashGap;
+
+  #if SERVO_SIM_PE_AMPLITUDE > 0
+    float phase = ((motorCounts % SERVO_SIM_PE_PERIOD) + axisFraction)/SERVO_SIM_PE_PERIOD;
+    axisFraction += SERVO_SIM_PE_AMPLITUDE*sinf(phase*2.0F*PI);
+  #endif
+
+  long encoderCounts = motorCounts + (long)floorf(axisFraction);
+
+  #if SERVO_SIM_QUANTIZE > 1
+    long remainder = encoderCounts % SERVO_SIM_QUANTIZE;
+    if (remainder < 0) remainder += SERVO_SIM_QUANTIZE;
+    encoderCounts -= remainder;
+  #endif
+
+  counts = encoderCounts;
+}
+
+#endif
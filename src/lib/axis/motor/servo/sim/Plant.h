@@ -0,0 +1,61 @@
+// -----------------------------------------------------------------------------------
+// axis servo simulated DC motor and gear train
+#pragma once
+
+#include <Arduino.h>
+#include "../../../../../Common.h"
+
+#ifdef SERVO_SIM_PRESENT
+
+#ifndef SERVO_SIM_TIME_CONSTANT
+  #define SERVO_SIM_TIME_CONSTANT 40       // mechanical time constant, in ms
+#endif
+#ifndef SERVO_SIM_FRICTION
+  #define SERVO_SIM_FRICTION 5             // running friction, in % of full power
+#endif
+#ifndef SERVO_SIM_STICTION
+  #define SERVO_SIM_STICTION 8             // breakaway friction, in % of full power
+#endif
+#ifndef SERVO_SIM_BACKLASH
+  #define SERVO_SIM_BACKLASH 20            // gear train backlash, in encoder counts
+#endif
+#ifndef SERVO_SIM_PE_AMPLITUDE
+  #define SERVO_SIM_PE_AMPLITUDE 0         // gear periodic error, in encoder counts
+#endif
+#ifndef SERVO_SIM_PE_PERIOD
+  #define SERVO_SIM_PE_PERIOD 100000       // gear periodic error period, in encoder counts of axis travel
+#endif
+#ifndef SERVO_SIM_QUANTIZE
+  #define SERVO_SIM_QUANTIZE 1             // encoder counts per reported step
+#endif
+
+// a voltage driven DC motor with the back-EMF and viscous losses lumped into one time constant, running
+// and breakaway friction, then a gear train with backlash and periodic error to the encoder on the axis,
+// velocities and positions are in encoder counts and counts per second at the axis
+class ServoSimPlant {
+  public:
+    // advance the plant to the present time
+    // \param power from -1.0 to 1.0 (full power in reverse to full power forward)
+    // \param velocityMax the no load velocity at full power, in counts per second
+    void update(float power, float velocityMax);
+
+    // stop the motor where it is, for example when the driver is disabled
+    void stop() { motorVelocity = 0.0F; }
+
+    // the encoder reading, quantized as set by SERVO_SIM_QUANTIZE
+    inline long read() { return counts; }
+
+    // motor velocity in counts per second
+    inline float velocity() { return motorVelocity; }
+
+  private:
+    float motorVelocity = 0.0F;     // counts/s
+    long motorCounts = 0;           // motor side of the gear train, whole counts
+    float motorFraction = 0.0F;     // and the fraction of a count, kept apart so slow motion isn't lost to float precision
+    float backlashGap = 0.0F;       // motor position less axis position, within +/- half the backlash
+    volatile long counts = 0;       // as last reported by the encoder
+
+    unsigned long lastUpdateUs = 0;
+};
+
+#endif
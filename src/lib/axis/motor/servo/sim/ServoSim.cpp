@@ -0,0 +1,47 @@
+// -----------------------------------------------------------------------------------
+// axis servo simulated motor driver
+
+#include "ServoSim.h"
+
+#ifdef SERVO_SIM_PRESENT
+
+ServoSim::ServoSim(uint8_t axisNumber, const ServoSettings *Settings, ServoSimPlant *plant)
+                   :ServoDriver(axisNumber, NULL, Settings) {
+  if (axisNumber < 1 || axisNumber > 9) return;
+
+  strcpy(axisPrefix, " Axis_ServoSim, ");
+  axisPrefix[5] = '0' + axisNumber;
+
+  this->plant = plant;
+}
+
+bool ServoSim::init(bool reverse) {
+  if (!ServoDriver::init(reverse)) return false;
+
+  // nothing to report faults
+  status.active = false;
+
+  VF("MSG:"); V(axisPrefix); VF("plant time constant "); V(SERVO_SIM_TIME_CONSTANT); VF("ms, friction "); V(SERVO_SIM_FRICTION);
+  VF("%, stiction "); V(SERVO_SIM_STICTION); VF("%, backlash "); V(SERVO_SIM_BACKLASH); VLF(" counts");
+
+  return true;
+}
+
+// enable or disable the driver using the enable pin or other method
+void ServoSim::enable(bool state) {
+  ServoDriver::enable(state);
+
+  VF("MSG:"); V(axisPrefix); VF("powered "); if (state) { VLF("up"); } else { VLF("down"); }
+}
+
+IRAM_ATTR float ServoSim::setMotorVelocity(float velocity) {
+  velocity = ServoDriver::setMotorVelocity(velocity);
+
+  float power = velocity*InvVelocityMax;
+  if (reversed) power = -power;
+  plant->update(power, velocityMax);
+
+  return velocity;
+}
+
+#endif
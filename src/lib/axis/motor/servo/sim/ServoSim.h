@@ -0,0 +1,41 @@
+// -----------------------------------------------------------------------------------
+// axis servo simulated motor driver
+#pragma once
+
+#include <Arduino.h>
+#include "../../../../../Common.h"
+
+#ifdef SERVO_SIM_PRESENT
+
+#include "../ServoDriver.h"
+#include "Plant.h"
+
+// drives the simulated plant in place of a motor, the power is the velocity command as a fraction
+// of the maximum velocity just like the DC motor drivers
+class ServoSim : public ServoDriver {
+  public:
+    // constructor
+    ServoSim(uint8_t axisNumber, const ServoSettings *Settings, ServoSimPlant *plant);
+
+    // decodes driver model and sets up the pin modes
+    bool init(bool reverse);
+
+    // enable or disable the driver using the enable pin or other method
+    void enable(bool state);
+
+    // plant math only
+    bool isrSafe() { return true; }
+
+    // set motor velocity
+    // \param velocity as needed to reach the target position, in encoder counts per second
+    // \returns velocity in effect, in encoder counts per second
+    float setMotorVelocity(float velocity);
+
+    // get the driver name
+    const char* name() { return "Simulated DC"; }
+
+  private:
+    ServoSimPlant *plant;
+};
+
+#endif
@@ -0,0 +1,41 @@
+// -----------------------------------------------------------------------------------
+// axis servo simulated encoder
+
+#include "SimEncoder.h"
+
+#ifdef SERVO_SIM_PRESENT
+
+ServoSimEncoder::ServoSimEncoder(int16_t axis, ServoSimPlant *plant) {
+  if (axis < 1 || axis > 9) return;
+
+  this->axis = axis;
+  this->plant = plant;
+}
+
+bool ServoSimEncoder::init() {
+  if (ready) return true;
+  if (!Encoder::init()) return false;
+
+  ready = true;
+  return true;
+}
+
+IRAM_ATTR int32_t ServoSimEncoder::read() {
+  if (!ready) return 0;
+
+  count = plant->read();
+
+  #if ENCODER_VELOCITY == ON
+    velNoteSampledCount(count);
+  #endif
+
+  return count + index;
+}
+
+void ServoSimEncoder::write(int32_t position) {
+  if (!ready) return;
+
+  index = position - plant->read();
+}
+
+#endif
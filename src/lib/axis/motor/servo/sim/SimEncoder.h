@@ -0,0 +1,30 @@
+// -----------------------------------------------------------------------------------
+// axis servo simulated encoder
+#pragma once
+
+#include <Arduino.h>
+#include "../../../../../Common.h"
+
+#ifdef SERVO_SIM_PRESENT
+
+#include "../../../../encoder/EncoderBase.h"
+#include "Plant.h"
+
+// for example:
+// ServoSimPlant plant1;
+// ServoSimEncoder encoder1(1, &plant1);
+
+// reads the axis position of the simulated plant
+class ServoSimEncoder : public Encoder {
+  public:
+    ServoSimEncoder(int16_t axis, ServoSimPlant *plant);
+    bool init();
+
+    int32_t read();
+    void write(int32_t position);
+
+  private:
+    ServoSimPlant *plant;
+};
+
+#endif
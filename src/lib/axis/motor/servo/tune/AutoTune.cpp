@@ -0,0 +1,85 @@
+// -----------------------------------------------------------------------------------
+// axis servo motor, relay feedback auto-tune
+
+#include "AutoTune.h"
+
+#if defined(SERVO_MOTOR_PRESENT) && SERVO_AUTOTUNE == ON
+
+void ServoAutoTune::start(long center, float velocity) {
+  this->center = center;
+  this->velocity = fabsf(velocity);
+
+  // moving a full second of relay velocity past the switch point means the plant isn't following the relay
+  excursionLimit = lroundf(this->velocity) + SERVO_AUTOTUNE_HYSTERESIS;
+
+  output = this->velocity;
+  startTime = micros();
+  lastRisingTime = startTime;
+  peakHigh = center;
+  peakLow = center;
+  risingCount = 0;
+  cycles = 0;
+  periodSum = 0.0F;
+  amplitudeSum = 0.0F;
+  ultimateGain = 0.0F;
+  ultimatePeriod = 0.0F;
+
+  state = AT_RELAY;
+}
+
+IRAM_ATTR float ServoAutoTune::update(long encoderCounts) {
+  if (state != AT_RELAY) return 0.0F;
+
+  const unsigned long now = micros();
+  long error = center - encoderCounts;
+
+  if (labs(error) > excursionLimit || (long)(now - startTime) > SERVO_AUTOTUNE_TIMEOUT_MS*1000L) {
+    state = AT_FAILED;
+    return 0.0F;
+  }
+
+  if (encoderCounts > peakHigh) peakHigh = encoderCounts;
+  if (encoderCounts < peakLow) peakLow = encoderCounts;
+
+  if (output < 0.0F && error > SERVO_AUTOTUNE_HYSTERESIS) {
+    // each switch to forward ends a full cycle, the first is discarded since it started at rest
+    output = velocity;
+    if (risingCount > 0) {
+      periodSum += (float)(now - lastRisingTime);
+      amplitudeSum += (peakHigh - peakLow)/2.0F;
+      cycles++;
+    }
+    risingCount++;
+    lastRisingTime = now;
+    peakHigh = encoderCounts;
+    peakLow = encoderCounts;
+
+    if (cycles >= SERVO_AUTOTUNE_CYCLES) { state = AT_ANALYZE; return 0.0F; }
+  } else
+  if (output > 0.0F && error < -SERVO_AUTOTUNE_HYSTERESIS) output = -velocity;
+
+  return output;
+}
+
+bool ServoAutoTune::analyze() {
+  if (state != AT_ANALYZE || cycles == 0) { state = AT_FAILED; return false; }
+
+  float amplitude = amplitudeSum/cycles;
+  ultimatePeriod = (periodSum/cycles)/1000000.0F;
+
+  // describing function of a relay with hysteresis
+  float h = SERVO_AUTOTUNE_HYSTERESIS;
+  if (amplitude <= h || ultimatePeriod <= 0.0F) { state = AT_FAILED; return false; }
+  ultimateGain = (4.0F*velocity)/(PI*sqrtf(amplitude*amplitude - h*h));
+
+  VF("MSG: ServoAutoTune, amplitude "); V(amplitude); VF(" counts, Ku "); V(ultimateGain); VF(", Tu "); V(ultimatePeriod); VLF("s");
+
+  state = AT_DONE;
+  return true;
+}
+
+void ServoAutoTune::abort() {
+  if (state == AT_RELAY || state == AT_ANALYZE) state = AT_FAILED;
+}
+
+#endif
@@ -0,0 +1,73 @@
+// -----------------------------------------------------------------------------------
+// axis servo motor, relay feedback auto-tune
+#pragma once
+
+#include "../../../../../Common.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+#ifndef SERVO_AUTOTUNE
+  #define SERVO_AUTOTUNE OFF
+#endif
+
+#if SERVO_AUTOTUNE == ON
+
+#ifndef SERVO_AUTOTUNE_HYSTERESIS
+  #define SERVO_AUTOTUNE_HYSTERESIS 4        // relay switching band, +/- encoder counts about the start position
+#endif
+#ifndef SERVO_AUTOTUNE_CYCLES
+  #define SERVO_AUTOTUNE_CYCLES 4            // oscillation cycles averaged, after the first is discarded
+#endif
+#ifndef SERVO_AUTOTUNE_TIMEOUT_MS
+  #define SERVO_AUTOTUNE_TIMEOUT_MS 30000    // the test fails if it takes longer than this
+#endif
+
+enum AutoTuneState {AT_IDLE, AT_RELAY, AT_ANALYZE, AT_DONE, AT_FAILED};
+
+// relay feedback test, the motor is driven at +/- a fixed velocity switching on the sign of the
+// position error so the axis oscillates about the start position at its ultimate period, the
+// amplitude of that oscillation then gives the ultimate gain
+class ServoAutoTune {
+  public:
+    // start the test about the center position (in counts) with the relay velocity (in counts/s)
+    void start(long center, float velocity);
+
+    // called each control loop sample with the encoder position (in counts)
+    // \returns the velocity command in counts/s
+    float update(long encoderCounts);
+
+    // end the test once the cycles are collected
+    // \returns true if the ultimate gain and period are valid
+    bool analyze();
+
+    // stop the test early
+    void abort();
+
+    // true while the relay is driving the motor
+    inline bool active() { return state == AT_RELAY; }
+
+    volatile AutoTuneState state = AT_IDLE;
+
+    float ultimateGain = 0.0F;   // in counts/s per count of error
+    float ultimatePeriod = 0.0F; // in seconds
+
+  private:
+    long center = 0;
+    float velocity = 0.0F;
+    float output = 0.0F;
+    long excursionLimit = 0;
+
+    unsigned long startTime = 0;
+    unsigned long lastRisingTime = 0;
+    long peakHigh = 0;
+    long peakLow = 0;
+    int risingCount = 0;
+
+    int cycles = 0;
+    float periodSum = 0.0F;
+    float amplitudeSum = 0.0F;
+};
+
+#endif
+
+#endif
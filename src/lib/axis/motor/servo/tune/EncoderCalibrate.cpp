@@ -0,0 +1,145 @@
+// -----------------------------------------------------------------------------------
+// axis servo motor, absolute encoder error calibration
+
+#include "EncoderCalibrate.h"
+
+#if defined(SERVO_MOTOR_PRESENT) && ENCODER_CORRECTION == ON
+
+void ServoEncoderCalibrate::start(float velocity, uint32_t countsPerTurn) {
+  this->velocity = velocity;
+  this->countsPerTurn = countsPerTurn;
+  binScale = ((uint64_t)ENCODER_CALIBRATE_BINS << 32)/countsPerTurn;
+
+  startTime = micros();
+  lastTime = startTime;
+  lastMoveTime = startTime;
+  elapsed = 0.0;
+  recording = false;
+  lastTurnCount = 0;
+  turnProgress = 0;
+
+  samples = 0;
+  meanT = 0.0;
+  meanY = 0.0;
+  slope = 0.0;
+  for (int i = 0; i < ENCODER_CALIBRATE_BINS; i++) {
+    binSumT[i] = 0.0;
+    binSumY[i] = 0.0;
+    binSamples[i] = 0;
+  }
+  amplitude = 0.0F;
+  residual = 0.0F;
+
+  state = EC_SWEEP;
+}
+
+IRAM_ATTR float ServoEncoderCalibrate::update(uint32_t turnCount) {
+  if (state != EC_SWEEP) return 0.0F;
+
+  const unsigned long now = micros();
+
+  // movement since the last sample, a change of more than half a turn is the count wrapping
+  int64_t change = (int64_t)turnCount - (int64_t)lastTurnCount;
+  if (change > (int64_t)(countsPerTurn/2)) change -= countsPerTurn; else
+  if (change < -(int64_t)(countsPerTurn/2)) change += countsPerTurn;
+  lastTurnCount = turnCount;
+
+  if (change != 0) lastMoveTime = now;
+  if ((long)(now - lastMoveTime) > ENCODER_CALIBRATE_STALL_MS*1000L) { state = EC_FAILED; return 0.0F; }
+
+  // let the motor reach a steady velocity first
+  if (!recording) {
+    if ((long)(now - startTime) < ENCODER_CALIBRATE_SETTLE_MS*1000L) return velocity;
+    recording = true;
+  } else {
+    elapsed += (now - lastTime)/1000000.0;
+    turnProgress += change;
+  }
+  lastTime = now;
+
+  // running means of time and progress for the straight line
+  const double y = (double)turnProgress;
+  samples++;
+  meanT += (elapsed - meanT)/samples;
+  meanY += (y - meanY)/samples;
+
+  const uint32_t bin = (uint32_t)(((uint64_t)turnCount*binScale) >> 32);
+  if (bin < ENCODER_CALIBRATE_BINS) {
+    binSumT[bin] += elapsed;
+    binSumY[bin] += y;
+    binSamples[bin]++;
+  }
+
+  // one turn later the encoder is back at the same error, so the velocity over the sweep is exact
+  if ((uint64_t)(turnProgress < 0 ? -turnProgress : turnProgress) >= countsPerTurn) {
+    if (elapsed > 0.0) slope = y/elapsed;
+    state = EC_ANALYZE;
+    return 0.0F;
+  }
+
+  return velocity;
+}
+
+bool ServoEncoderCalibrate::analyze(EncoderCorrection &harmonics) {
+  if (state != EC_ANALYZE || samples < 2 || slope == 0.0) { state = EC_FAILED; return false; }
+
+  const double offset = meanY - slope*meanT;
+
+  // the error in each bin is how far the encoder was from the straight line there
+  float error[ENCODER_CALIBRATE_BINS];
+  float mean = 0.0F;
+  for (int i = 0; i < ENCODER_CALIBRATE_BINS; i++) {
+    if (binSamples[i] == 0) {
+      VF("MSG: ServoEncoderCalibrate, no samples in bin "); VL(i);
+      state = EC_FAILED;
+      return false;
+    }
+    error[i] = (float)((binSumY[i] - slope*binSumT[i])/binSamples[i] - offset);
+    mean += error[i];
+  }
+  mean /= ENCODER_CALIBRATE_BINS;
+  for (int i = 0; i < ENCODER_CALIBRATE_BINS; i++) error[i] -= mean;
+
+  // harmonics of the bin centers, averaging over a bin lowers each harmonic a little so put that back
+  harmonics.countsPerTurn = countsPerTurn;
+  for (int k = 0; k < ENCODER_CORRECTION_HARMONICS; k++) {
+    float c = 0.0F;
+    float s = 0.0F;
+    for (int i = 0; i < ENCODER_CALIBRATE_BINS; i++) {
+      const float angle = (2.0F*(float)PI*(k + 1)*(i + 0.5F))/ENCODER_CALIBRATE_BINS;
+      c += error[i]*cosf(angle);
+      s += error[i]*sinf(angle);
+    }
+    const float x = ((float)PI*(k + 1))/ENCODER_CALIBRATE_BINS;
+    const float gain = (2.0F/ENCODER_CALIBRATE_BINS)*(x/sinf(x));
+    harmonics.cosine[k] = c*gain;
+    harmonics.sine[k] = s*gain;
+  }
+
+  // how much is corrected and what's left
+  float peak = 0.0F;
+  float sumSquares = 0.0F;
+  for (int i = 0; i < ENCODER_CALIBRATE_BINS; i++) {
+    const float angle = (2.0F*(float)PI*(i + 0.5F))/ENCODER_CALIBRATE_BINS;
+    float model = 0.0F;
+    for (int k = 0; k < ENCODER_CORRECTION_HARMONICS; k++) {
+      model += harmonics.cosine[k]*cosf((k + 1)*angle) + harmonics.sine[k]*sinf((k + 1)*angle);
+    }
+    if (fabsf(model) > peak) peak = fabsf(model);
+    sumSquares += (error[i] - model)*(error[i] - model);
+  }
+  amplitude = peak;
+  residual = sqrtf(sumSquares/ENCODER_CALIBRATE_BINS);
+
+  VF("MSG: ServoEncoderCalibrate, "); V(samples); VF(" samples, error "); V(amplitude);
+  VF(" counts peak, "); V(residual); VLF(" counts rms left");
+
+  state = EC_DONE;
+  return true;
+}
+
+void ServoEncoderCalibrate::abort() {
+  if (state == EC_SWEEP || state == EC_ANALYZE) state = EC_FAILED;
+}
+
+#endif
@@ -0,0 +1,80 @@
+// -----------------------------------------------------------------------------------
+// axis servo motor, absolute encoder error calibration
+#pragma once
+
+#include "../../../../../Common.h"
+
+#ifdef SERVO_MOTOR_PRESENT
+
+#include "../../../../encoder/EncoderBase.h"
+
+#if ENCODER_CORRECTION == ON
+
+#define ENCODER_CALIBRATE_BINS 128         // phase bins over one turn, the harmonics are found from these
+
+#ifndef ENCODER_CALIBRATE_SETTLE_MS
+  #define ENCODER_CALIBRATE_SETTLE_MS 2000 // time for the sweep to reach a steady velocity before recording
+#endif
+#ifndef ENCODER_CALIBRATE_STALL_MS
+  #define ENCODER_CALIBRATE_STALL_MS 5000  // the sweep fails if the encoder doesn't move for this long
+#endif
+
+enum EncoderCalibrateState {EC_IDLE, EC_SWEEP, EC_ANALYZE, EC_DONE, EC_FAILED};
+
+// the motor is driven open loop at a constant velocity for one turn of the encoder, so the commanded
+// motion (the motor steps of a stepper based servo) is a straight line in time, the encoder's single
+// turn count (unwrapped) less a straight line through it is then the encoder's error, which is
+// averaged in bins over the turn and reduced to the harmonics of one turn
+class ServoEncoderCalibrate {
+  public:
+    // start the sweep at the velocity (in counts/s, either direction)
+    // \param countsPerTurn: single turn counts of the encoder
+    void start(float velocity, uint32_t countsPerTurn);
+
+    // called each control loop sample with the encoder's single turn count (before correction)
+    // \returns the velocity command in counts/s
+    float update(uint32_t turnCount);
+
+    // find the harmonics of the error, in single turn counts, once the sweep is done
+    // \returns true if the harmonics are valid
+    bool analyze(EncoderCorrection &harmonics);
+
+    // stop the sweep early
+    void abort();
+
+    // true while the sweep is driving the motor
+    inline bool active() { return state == EC_SWEEP; }
+
+    volatile EncoderCalibrateState state = EC_IDLE;
+
+    float amplitude = 0.0F;  // peak error corrected, in single turn counts
+    float residual = 0.0F;   // rms error left after the correction, in single turn counts
+
+  private:
+    float velocity = 0.0F;
+    uint32_t countsPerTurn = 0;
+    uint64_t binScale = 0;          // single turn count to bin, 32.32 fixed point
+
+    unsigned long startTime = 0;
+    unsigned long lastTime = 0;
+    unsigned long lastMoveTime = 0;
+    double elapsed = 0.0;           // in seconds since recording started
+    bool recording = false;
+
+    // progress over the turn, in single turn counts
+    uint32_t lastTurnCount = 0;
+    int64_t turnProgress = 0;
+
+    // the straight line of progress in time, from the means and the velocity over the whole turn (a line
+    // fitted to the samples would take up part of the first harmonic), then sums by bin
+    uint32_t samples = 0;
+    double meanT = 0.0, meanY = 0.0;
+    double slope = 0.0;             // in single turn counts per second
+    double binSumT[ENCODER_CALIBRATE_BINS];
+    double binSumY[ENCODER_CALIBRATE_BINS];
+    uint32_t binSamples[ENCODER_CALIBRATE_BINS];
+};
+
+#endif
+
+#endif
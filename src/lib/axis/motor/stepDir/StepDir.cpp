@@ -9,68 +9,83 @@
 
 static StepDirMotor *stepDirMotorInstance[9];
 
+#if STEP_DIR_PROFILER == ON
+  #define STEP_DIR_PROFILE(n, isr, call) { long p0 = stepDirMotorInstance[n]->profilePosition(); long e0 = stepDirMotorInstance[n]->profileError(); uint32_t t0 = HAL_FAST_TICKS(); call; stepDirMotorInstance[n]->profile(isr, t0, p0, e0); }
+#else
+  #define STEP_DIR_PROFILE(n, isr, call) call
+#endif
+
 #ifndef AXIS1_STEP_PIN
   #define AXIS1_STEP_PIN stepDirMotorInstance[0]->Pins->step
 #endif
-IRAM_ATTR void moveStepDirMotorAxis1() { stepDirMotorInstance[0]->move(AXIS1_STEP_PIN); }
-IRAM_ATTR void moveStepDirMotorFFAxis1() { stepDirMotorInstance[0]->moveFF(AXIS1_STEP_PIN); }
-IRAM_ATTR void moveStepDirMotorFRAxis1() { stepDirMotorInstance[0]->moveFR(AXIS1_STEP_PIN); }
+IRAM_ATTR void moveStepDirMotorAxis1() { STEP_DIR_PROFILE(0, STEP_DIR_ISR_MOVE, stepDirMotorInstance[0]->move(AXIS1_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorTAxis1() { STEP_DIR_PROFILE(0, STEP_DIR_ISR_MOVE_T, stepDirMotorInstance[0]->moveT(AXIS1_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFFAxis1() { STEP_DIR_PROFILE(0, STEP_DIR_ISR_MOVE_FF, stepDirMotorInstance[0]->moveFF(AXIS1_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFRAxis1() { STEP_DIR_PROFILE(0, STEP_DIR_ISR_MOVE_FR, stepDirMotorInstance[0]->moveFR(AXIS1_STEP_PIN)); }
 
 #ifndef AXIS2_STEP_PIN
   #define AXIS2_STEP_PIN stepDirMotorInstance[1]->Pins->step
 #endif
-IRAM_ATTR void moveStepDirMotorAxis2() { stepDirMotorInstance[1]->move(AXIS2_STEP_PIN); }
-IRAM_ATTR void moveStepDirMotorFFAxis2() { stepDirMotorInstance[1]->moveFF(AXIS2_STEP_PIN); }
-IRAM_ATTR void moveStepDirMotorFRAxis2() { stepDirMotorInstance[1]->moveFR(AXIS2_STEP_PIN); }
+IRAM_ATTR void moveStepDirMotorAxis2() { STEP_DIR_PROFILE(1, STEP_DIR_ISR_MOVE, stepDirMotorInstance[1]->move(AXIS2_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorTAxis2() { STEP_DIR_PROFILE(1, STEP_DIR_ISR_MOVE_T, stepDirMotorInstance[1]->moveT(AXIS2_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFFAxis2() { STEP_DIR_PROFILE(1, STEP_DIR_ISR_MOVE_FF, stepDirMotorInstance[1]->moveFF(AXIS2_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFRAxis2() { STEP_DIR_PROFILE(1, STEP_DIR_ISR_MOVE_FR, stepDirMotorInstance[1]->moveFR(AXIS2_STEP_PIN)); }
 
 #ifndef AXIS3_STEP_PIN
   #define AXIS3_STEP_PIN stepDirMotorInstance[2]->Pins->step
 #endif
-IRAM_ATTR void moveStepDirMotorAxis3() { stepDirMotorInstance[2]->move(AXIS3_STEP_PIN); }
-IRAM_ATTR void moveStepDirMotorFFAxis3() { stepDirMotorInstance[2]->moveFF(AXIS3_STEP_PIN); }
-IRAM_ATTR void moveStepDirMotorFRAxis3() { stepDirMotorInstance[2]->moveFR(AXIS3_STEP_PIN); }
+IRAM_ATTR void moveStepDirMotorAxis3() { STEP_DIR_PROFILE(2, STEP_DIR_ISR_MOVE, stepDirMotorInstance[2]->move(AXIS3_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorTAxis3() { STEP_DIR_PROFILE(2, STEP_DIR_ISR_MOVE_T, stepDirMotorInstance[2]->moveT(AXIS3_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFFAxis3() { STEP_DIR_PROFILE(2, STEP_DIR_ISR_MOVE_FF, stepDirMotorInstance[2]->moveFF(AXIS3_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFRAxis3() { STEP_DIR_PROFILE(2, STEP_DIR_ISR_MOVE_FR, stepDirMotorInstance[2]->moveFR(AXIS3_STEP_PIN)); }
 
 #ifndef AXIS4_STEP_PIN
   #define AXIS4_STEP_PIN stepDirMotorInstance[3]->Pins->step
 #endif
-void moveStepDirMotorAxis4() { stepDirMotorInstance[3]->move(AXIS4_STEP_PIN); }
-void moveStepDirMotorFFAxis4() { stepDirMotorInstance[3]->moveFF(AXIS4_STEP_PIN); }
-void moveStepDirMotorFRAxis4() { stepDirMotorInstance[3]->moveFR(AXIS4_STEP_PIN); }
+IRAM_ATTR void moveStepDirMotorAxis4() { STEP_DIR_PROFILE(3, STEP_DIR_ISR_MOVE, stepDirMotorInstance[3]->move(AXIS4_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorTAxis4() { STEP_DIR_PROFILE(3, STEP_DIR_ISR_MOVE_T, stepDirMotorInstance[3]->moveT(AXIS4_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFFAxis4() { STEP_DIR_PROFILE(3, STEP_DIR_ISR_MOVE_FF, stepDirMotorInstance[3]->moveFF(AXIS4_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFRAxis4() { STEP_DIR_PROFILE(3, STEP_DIR_ISR_MOVE_FR, stepDirMotorInstance[3]->moveFR(AXIS4_STEP_PIN)); }
 
 #ifndef AXIS5_STEP_PIN
   #define AXIS5_STEP_PIN stepDirMotorInstance[4]->Pins->step
 #endif
-void moveStepDirMotorAxis5() { stepDirMotorInstance[4]->move(AXIS5_STEP_PIN); }
-void moveStepDirMotorFFAxis5() { stepDirMotorInstance[4]->moveFF(AXIS5_STEP_PIN); }
-void moveStepDirMotorFRAxis5() { stepDirMotorInstance[4]->moveFR(AXIS5_STEP_PIN); }
+IRAM_ATTR void moveStepDirMotorAxis5() { STEP_DIR_PROFILE(4, STEP_DIR_ISR_MOVE, stepDirMotorInstance[4]->move(AXIS5_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorTAxis5() { STEP_DIR_PROFILE(4, STEP_DIR_ISR_MOVE_T, stepDirMotorInstance[4]->moveT(AXIS5_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFFAxis5() { STEP_DIR_PROFILE(4, STEP_DIR_ISR_MOVE_FF, stepDirMotorInstance[4]->moveFF(AXIS5_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFRAxis5() { STEP_DIR_PROFILE(4, STEP_DIR_ISR_MOVE_FR, stepDirMotorInstance[4]->moveFR(AXIS5_STEP_PIN)); }
 
 #ifndef AXIS6_STEP_PIN
   #define AXIS6_STEP_PIN stepDirMotorInstance[5]->Pins->step
 #endif
-void moveStepDirMotorAxis6() { stepDirMotorInstance[5]->move(AXIS6_STEP_PIN); }
-void moveStepDirMotorFFAxis6() { stepDirMotorInstance[5]->moveFF(AXIS6_STEP_PIN); }
-void moveStepDirMotorFRAxis6() { stepDirMotorInstance[5]->moveFR(AXIS6_STEP_PIN); }
+IRAM_ATTR void moveStepDirMotorAxis6() { STEP_DIR_PROFILE(5, STEP_DIR_ISR_MOVE, stepDirMotorInstance[5]->move(AXIS6_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorTAxis6() { STEP_DIR_PROFILE(5, STEP_DIR_ISR_MOVE_T, stepDirMotorInstance[5]->moveT(AXIS6_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFFAxis6() { STEP_DIR_PROFILE(5, STEP_DIR_ISR_MOVE_FF, stepDirMotorInstance[5]->moveFF(AXIS6_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFRAxis6() { STEP_DIR_PROFILE(5, STEP_DIR_ISR_MOVE_FR, stepDirMotorInstance[5]->moveFR(AXIS6_STEP_PIN)); }
 
 #ifndef AXIS7_STEP_PIN
   #define AXIS7_STEP_PIN stepDirMotorInstance[6]->Pins->step
 #endif
-void moveStepDirMotorAxis7() { stepDirMotorInstance[6]->move(AXIS7_STEP_PIN); }
-void moveStepDirMotorFFAxis7() { stepDirMotorInstance[6]->moveFF(AXIS7_STEP_PIN); }
-void moveStepDirMotorFRAxis7() { stepDirMotorInstance[6]->moveFR(AXIS7_STEP_PIN); }
+IRAM_ATTR void moveStepDirMotorAxis7() { STEP_DIR_PROFILE(6, STEP_DIR_ISR_MOVE, stepDirMotorInstance[6]->move(AXIS7_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorTAxis7() { STEP_DIR_PROFILE(6, STEP_DIR_ISR_MOVE_T, stepDirMotorInstance[6]->moveT(AXIS7_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFFAxis7() { STEP_DIR_PROFILE(6, STEP_DIR_ISR_MOVE_FF, stepDirMotorInstance[6]->moveFF(AXIS7_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFRAxis7() { STEP_DIR_PROFILE(6, STEP_DIR_ISR_MOVE_FR, stepDirMotorInstance[6]->moveFR(AXIS7_STEP_PIN)); }
 
 #ifndef AXIS8_STEP_PIN
   #define AXIS8_STEP_PIN stepDirMotorInstance[7]->Pins->step
 #endif
-void moveStepDirMotorAxis8() { stepDirMotorInstance[7]->move(AXIS8_STEP_PIN); }
-void moveStepDirMotorFFAxis8() { stepDirMotorInstance[7]->moveFF(AXIS8_STEP_PIN); }
-void moveStepDirMotorFRAxis8() { stepDirMotorInstance[7]->moveFR(AXIS8_STEP_PIN); }
+IRAM_ATTR void moveStepDirMotorAxis8() { STEP_DIR_PROFILE(7, STEP_DIR_ISR_MOVE, stepDirMotorInstance[7]->move(AXIS8_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorTAxis8() { STEP_DIR_PROFILE(7, STEP_DIR_ISR_MOVE_T, stepDirMotorInstance[7]->moveT(AXIS8_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFFAxis8() { STEP_DIR_PROFILE(7, STEP_DIR_ISR_MOVE_FF, stepDirMotorInstance[7]->moveFF(AXIS8_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFRAxis8() { STEP_DIR_PROFILE(7, STEP_DIR_ISR_MOVE_FR, stepDirMotorInstance[7]->moveFR(AXIS8_STEP_PIN)); }
 
 #ifndef AXIS9_STEP_PIN
   #define AXIS9_STEP_PIN stepDirMotorInstance[8]->Pins->step
 #endif
-void moveStepDirMotorAxis9() { stepDirMotorInstance[8]->move(AXIS9_STEP_PIN); }
-void moveStepDirMotorFFAxis9() { stepDirMotorInstance[8]->moveFF(AXIS9_STEP_PIN); }
-void moveStepDirMotorFRAxis9() { stepDirMotorInstance[8]->moveFR(AXIS9_STEP_PIN); }
+IRAM_ATTR void moveStepDirMotorAxis9() { STEP_DIR_PROFILE(8, STEP_DIR_ISR_MOVE, stepDirMotorInstance[8]->move(AXIS9_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorTAxis9() { STEP_DIR_PROFILE(8, STEP_DIR_ISR_MOVE_T, stepDirMotorInstance[8]->moveT(AXIS9_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFFAxis9() { STEP_DIR_PROFILE(8, STEP_DIR_ISR_MOVE_FF, stepDirMotorInstance[8]->moveFF(AXIS9_STEP_PIN)); }
+IRAM_ATTR void moveStepDirMotorFRAxis9() { STEP_DIR_PROFILE(8, STEP_DIR_ISR_MOVE_FR, stepDirMotorInstance[8]->moveFR(AXIS9_STEP_PIN)); }
 
 StepDirMotor::StepDirMotor(uint8_t axisNumber, int8_t reverse,
                            const StepDirPins *Pins, StepDirDriver *Driver, bool useFastHardwareTimers)
@@ -91,15 +106,15 @@ StepDirMotor::StepDirMotor(uint8_t axisNumber, int8_t reverse,
   // attach the function pointers to the callbacks
   stepDirMotorInstance[axisNumber - 1] = this;
   switch (axisNumber) {
-    case 1: callback = moveStepDirMotorAxis1; callbackFF = moveStepDirMotorFFAxis1; callbackFR = moveStepDirMotorFRAxis1; break;
-    case 2: callback = moveStepDirMotorAxis2; callbackFF = moveStepDirMotorFFAxis2; callbackFR = moveStepDirMotorFRAxis2; break;
-    case 3: callback = moveStepDirMotorAxis3; callbackFF = moveStepDirMotorFFAxis3; callbackFR = moveStepDirMotorFRAxis3; break;
-    case 4: callback = moveStepDirMotorAxis4; callbackFF = moveStepDirMotorFFAxis4; callbackFR = moveStepDirMotorFRAxis4; break;
-    case 5: callback = moveStepDirMotorAxis5; callbackFF = moveStepDirMotorFFAxis5; callbackFR = moveStepDirMotorFRAxis5; break;
-    case 6: callback = moveStepDirMotorAxis6; callbackFF = moveStepDirMotorFFAxis6; callbackFR = moveStepDirMotorFRAxis6; break;
-    case 7: callback = moveStepDirMotorAxis7; callbackFF = moveStepDirMotorFFAxis7; callbackFR = moveStepDirMotorFRAxis7; break;
-    case 8: callback = moveStepDirMotorAxis8; callbackFF = moveStepDirMotorFFAxis8; callbackFR = moveStepDirMotorFRAxis8; break;
-    case 9: callback = moveStepDirMotorAxis9; callbackFF = moveStepDirMotorFFAxis9; callbackFR = moveStepDirMotorFRAxis9; break;
+    case 1: callback = moveStepDirMotorAxis1; callbackT = moveStepDirMotorTAxis1; callbackFF = moveStepDirMotorFFAxis1; callbackFR = moveStepDirMotorFRAxis1; break;
+    case 2: callback = moveStepDirMotorAxis2; callbackT = moveStepDirMotorTAxis2; callbackFF = moveStepDirMotorFFAxis2; callbackFR = moveStepDirMotorFRAxis2; break;
+    case 3: callback = moveStepDirMotorAxis3; callbackT = moveStepDirMotorTAxis3; callbackFF = moveStepDirMotorFFAxis3; callbackFR = moveStepDirMotorFRAxis3; break;
+    case 4: callback = moveStepDirMotorAxis4; callbackT = moveStepDirMotorTAxis4; callbackFF = moveStepDirMotorFFAxis4; callbackFR = moveStepDirMotorFRAxis4; break;
+    case 5: callback = moveStepDirMotorAxis5; callbackT = moveStepDirMotorTAxis5; callbackFF = moveStepDirMotorFFAxis5; callbackFR = moveStepDirMotorFRAxis5; break;
+    case 6: callback = moveStepDirMotorAxis6; callbackT = moveStepDirMotorTAxis6; callbackFF = moveStepDirMotorFFAxis6; callbackFR = moveStepDirMotorFRAxis6; break;
+    case 7: callback = moveStepDirMotorAxis7; callbackT = moveStepDirMotorTAxis7; callbackFF = moveStepDirMotorFFAxis7; callbackFR = moveStepDirMotorFRAxis7; break;
+    case 8: callback = moveStepDirMotorAxis8; callbackT = moveStepDirMotorTAxis8; callbackFF = moveStepDirMotorFFAxis8; callbackFR = moveStepDirMotorFRAxis8; break;
+    case 9: callback = moveStepDirMotorAxis9; callbackT = moveStepDirMotorTAxis9; callbackFF = moveStepDirMotorFFAxis9; callbackFR = moveStepDirMotorFRAxis9; break;
   }
 }
 
@@ -143,17 +158,23 @@ bool StepDirMotor::init() {
   if (!driver->init()) { DF("ERR:"); D(axisPrefix); DLF("no motor driver!"); return false; }
 
   // start the motor timer
-  VF("MSG:"); V(axisPrefix); VF("start task to move motor... ");
-  char timerName[] = "Motor_";
-  timerName[5] = '0' + axisNumber;
-  taskHandle = tasks.add(0, 0, true, 0, callback, timerName);
-  if (taskHandle) {
-    V("success");
-    if (useFastHardwareTimers && !tasks.requestHardwareTimer(taskHandle, 0)) { VLF(" (no hardware timer!)"); } else { VLF(""); }
-  } else {
-    VLF("FAILED!");
-    return false;
-  }
+  #if STEP_DIR_SCHEDULER == ON
+    if (!stepDirScheduler.init()) return false;
+    stepDirScheduler.setCallback(axisNumber, callback);
+    VF("MSG:"); V(axisPrefix); VLF("motor moved by the step scheduler");
+  #else
+    VF("MSG:"); V(axisPrefix); VF("start task to move motor... ");
+    char timerName[] = "Motor_";
+    timerName[5] = '0' + axisNumber;
+    taskHandle = tasks.add(0, 0, true, 0, callback, timerName);
+    if (taskHandle) {
+      V("success");
+      if (useFastHardwareTimers && !tasks.requestHardwareTimer(taskHandle, 0)) { VLF(" (no hardware timer!)"); } else { VLF(""); }
+    } else {
+      VLF("FAILED!");
+      return false;
+    }
+  #endif
 
   ready = true;
   return true;
@@ -224,16 +245,30 @@ void StepDirMotor::setFrequencySteps(float frequency) {
     }
   #endif
 
+  // a backlash preload waits for the motor to stop at its target and is dropped if motion starts first
+  if (backlashPreload != 0) {
+    if (frequency != 0.0F || microstepModeControl != MMC_TRACKING || backlashPreloadStart(backlashPreload)) backlashPreload = 0;
+  }
+
   if (!inBacklash) modeSwitch();
 
-  Y;
+  // while tracking without backlash use the reduced ISR, the general one handles backlash and mode switch requests
+  // so it goes back in as soon as modeSwitch() leaves tracking, the fast ISRs are swapped in later from there
+  if (microstepModeControl == MMC_TRACKING) {
+    void (*trackingCallback)() = (backlashAmountSteps == 0 && !inBacklash) ? callbackT : callback;
+    if (callbackActive != trackingCallback) setStepCallback(trackingCallback);
+  } else {
+    if (callbackActive == callbackT) setStepCallback(callback);
+  }
+
+  if (pollYield) Y;
   // negative frequency, convert to positive and reverse the direction
   int dir = 0;
   if (frequency > 0.0F) dir = 1; else if (frequency < 0.0F) { frequency = -frequency; dir = -1; }
 
   // if in backlash override the frequency OR change
   // microstep mode and/or swap in fast ISRs as required
-  if (inBacklash) frequency = backlashFrequency;
+  frequency = getBacklashTakeUpFrequency(frequency);
 
   if (frequency != currentFrequency || microstepModeControl >= MMC_SLEWING_PAUSE) {
     lastFrequency = frequency;
@@ -264,7 +299,9 @@ void StepDirMotor::setFrequencySteps(float frequency) {
     // change the motor rate/direction
     if (step != dir) step = 0;
     if (lastPeriodSet != lastPeriod) {
-      tasks.setPeriodSubMicros(taskHandle, lastPeriod);
+      // ramp only between rates in the same direction and microstep mode
+      bool ramp = dir != 0 && step == dir && lastPeriodSet != 0 && microstepModeControl <= MMC_SLEWING;
+      setStepPeriod(lastPeriod, ramp);
       lastPeriodSet = lastPeriod;
     }
     step = dir;
@@ -284,6 +321,45 @@ void StepDirMotor::setFrequencySteps(float frequency) {
   }
 }
 
+// start taking up backlash toward direction (1 or -1) while stopped at the target
+// returns false if the motor isn't stopped at its target yet
+bool StepDirMotor::backlashPreloadStart(int8_t direction) {
+  noInterrupts();
+  if (inBacklash || motorSteps != targetSteps) { interrupts(); return false; }
+
+  bool takeUp = direction > 0 ? backlashSteps < backlashAmountSteps && backlashForwardStart < backlashAmountSteps :
+                                backlashSteps > 0 && backlashReverseStart > 0;
+  if (takeUp) {
+    inBacklash = true;
+    #ifdef GPIO_DIRECTION_PINS
+      this->direction = direction > 0 ? DirSetFwd : DirSetRev;
+    #else
+      this->direction = direction > 0 ? dirFwd : dirRev;
+      digitalWriteF(Pins->dir, this->direction);
+    #endif
+  }
+  interrupts();
+
+  if (takeUp) { VF("MSG:"); V(axisPrefix); VF("backlash preload toward "); VL(direction > 0 ? "fwd" : "rev"); }
+  return true;
+}
+
+// set backlash amount in steps, each direction can have its own amount
+void StepDirMotor::setBacklashSteps(long value, long valueReverse) {
+  if (value < 0) value = 0;
+  if (value > 65535) value = 65535;
+  if (valueReverse < 0) valueReverse = value;
+  if (valueReverse > 65535) valueReverse = 65535;
+
+  // the backlash travel spans the larger amount, the smaller direction starts takeup part way in
+  uint16_t amount = max(value, valueReverse);
+  noInterrupts();
+  backlashAmountSteps = amount;
+  backlashForwardStart = amount - value;
+  backlashReverseStart = valueReverse;
+  interrupts();
+}
+
 // switch microstep modes as needed
 void StepDirMotor::modeSwitch() {
   if (lastFrequency <= backlashFrequency*2.0F) {
@@ -296,6 +372,9 @@ void StepDirMotor::modeSwitch() {
         VF("MSG:"); V(axisPrefix); VLF("mode switch tracking set");
         driver->modeMicrostepTracking();
       }
+      #if STEP_DIR_MICROSTEP_LEVELS == ON
+        stepSizeRequest = 0;
+      #endif
     }
   } else {
     if (microstepModeControl == MMC_TRACKING) {
@@ -308,15 +387,53 @@ void StepDirMotor::modeSwitch() {
     } else
     if (microstepModeControl == MMC_SLEWING_PAUSE) {
       if (driver->modeSwitchAllowed || driver->modeSwitchFastAllowed) {
-        VF("MSG:"); V(axisPrefix); VLF("mode switch slewing set");
-        stepSize = driver->modeMicrostepSlewing();
+        #if STEP_DIR_MICROSTEP_LEVELS == ON
+          // pick the resolution for the current speed, the ISR paused on a boundary of the larger step size
+          int levelStepSize = 0;
+          if (driver->hasMicrostepLevels()) {
+            int size = stepSizeRequest != 0 ? stepSizeRequest : microstepLevel(lastFrequency);
+            levelStepSize = driver->modeMicrostepLevel(driver->getMicrostepMode()/size);
+          }
+          if (levelStepSize != 0) {
+            VF("MSG:"); V(axisPrefix); VF("mode switch slewing set, step size "); VL(levelStepSize);
+            stepSize = levelStepSize;
+          } else
+        #endif
+        {
+          VF("MSG:"); V(axisPrefix); VLF("mode switch slewing set");
+          stepSize = driver->modeMicrostepSlewing();
+        }
       }
+      #if STEP_DIR_MICROSTEP_LEVELS == ON
+        stepSizeRequest = 0;
+      #endif
       enableMoveFast(true);
       microstepModeControl = MMC_SLEWING_READY;
     }
+    #if STEP_DIR_MICROSTEP_LEVELS == ON
+      else
+      if (microstepModeControl == MMC_SLEWING && stepSizeRequest == 0 && driver->hasMicrostepLevels() && (driver->modeSwitchAllowed || driver->modeSwitchFastAllowed)) {
+        // speed band changed, the ISR pauses at the next boundary and the frequency is rescaled for the new step size
+        int size = microstepLevel(lastFrequency);
+        if (size != stepSize) stepSizeRequest = size;
+      }
+    #endif
   }
 }
 
+#if STEP_DIR_MICROSTEP_LEVELS == ON
+  // get the slewing step size (in tracking mode steps) for this frequency in tracking mode steps per second
+  int StepDirMotor::microstepLevel(float frequency) {
+    int ratio = driver->getMicrostepRatio();
+    int size = 1;
+    while (size < ratio && frequency > (float)STEP_DIR_MICROSTEP_LEVEL_RATE*size) size *= 2;
+
+    // only move to a finer resolution once comfortably below its rate limit
+    if (size < stepSize && frequency > (float)STEP_DIR_MICROSTEP_LEVEL_RATE*size*0.75F) size = stepSize;
+    return size;
+  }
+#endif
+
 float StepDirMotor::getFrequencySteps() {
   if (!ready) return 0.0F;
 
@@ -346,19 +463,141 @@ bool StepDirMotor::isStalled(double axisPosition) {
 bool StepDirMotor::enableMoveFast(const bool fast) {
   if (fast) {
     if (direction == dirRev) {
-      tasks.setCallback(taskHandle, callbackFR);
+      setStepCallback(callbackFR);
       VF("MSG:"); V(axisPrefix); VF("high speed Rev ISR swapped in at "); V(lastFrequency); VLF(" steps/sec.");
     } else {
-      tasks.setCallback(taskHandle, callbackFF);
+      setStepCallback(callbackFF);
       VF("MSG:"); V(axisPrefix); VF("high speed Fwd ISR swapped in at "); V(lastFrequency); VLF(" steps/sec.");
     }
   } else {
-    tasks.setCallback(taskHandle, callback);
+    setStepCallback(callback);
     VF("MSG:"); V(axisPrefix); VF("high speed ISR swapped out at "); V(lastFrequency); VL(" steps/sec.");
   }
   return true;
 }
 
+#if STEP_DIR_PROFILER == ON
+  // get step ISR cost in fast ticks as min,avg,max for move, moveFF, moveFR, and moveT since the last call
+  bool StepDirMotor::getIsrProfile(char *reply, size_t replySize) {
+    if (!ready) return false;
+
+    StepDirIsrProfile p[4];
+    noInterrupts();
+    for (int i = 0; i < 4; i++) {
+      p[i] = isrProfile[i];
+      isrProfile[i] = {UINT32_MAX, 0, 0, 0};
+    }
+    interrupts();
+
+    reply[0] = 0;
+    for (int i = 0; i < 4; i++) {
+      char temp[36];
+      if (p[i].count == 0) strcpy(temp, "0,0,0"); else
+        snprintf(temp, sizeof(temp), "%lu,%lu,%lu", (unsigned long)p[i].min, (unsigned long)(p[i].total/p[i].count), (unsigned long)p[i].max);
+      if (i > 0) strncat(reply, ",", replySize - strlen(reply) - 1);
+      strncat(reply, temp, replySize - strlen(reply) - 1);
+    }
+    return true;
+  }
+
+  // get step timing accuracy since the last call as steps,avg jitter,max jitter (in fast ticks),max position error,calls behind target
+  bool StepDirMotor::getStepTiming(char *reply, size_t replySize) {
+    if (!ready) return false;
+
+    noInterrupts();
+    StepDirTiming t = timing;
+    timing = {0, 0, 0, 0, 0};
+    interrupts();
+
+    unsigned long jitterAverage = t.steps == 0 ? 0 : (unsigned long)(t.jitterTotal/t.steps);
+    snprintf(reply, replySize, "%lu,%lu,%lu,%lu,%lu", (unsigned long)t.steps, jitterAverage, (unsigned long)t.jitterMax,
+                                                      (unsigned long)t.positionErrorMax, (unsigned long)t.behind);
+    return true;
+  }
+
+  // record the cost and step timing of one step ISR call started at t0 (in fast ticks), from the ISR
+  IRAM_ATTR void StepDirMotor::profile(uint8_t isr, uint32_t t0, long position, long error) {
+    uint32_t ticks = HAL_FAST_TICKS() - t0;
+    StepDirIsrProfile *p = &isrProfile[isr];
+    if (ticks < p->min) p->min = ticks;
+    if (ticks > p->max) p->max = ticks;
+    p->total += ticks;
+    p->count++;
+
+    // a step edge, compare its interval to the commanded rate
+    if (motorSteps + backlashSteps != position) {
+      uint32_t expected = expectedStepTicks;
+      if (stepTimingValid && expected != 0) {
+        uint32_t interval = t0 - lastStepTicks;
+        uint32_t jitter = interval > expected ? interval - expected : expected - interval;
+        timing.steps++;
+        timing.jitterTotal += jitter;
+        if (jitter > timing.jitterMax) timing.jitterMax = jitter;
+      }
+      lastStepTicks = t0;
+      stepTimingValid = true;
+    }
+
+    // how closely the motor follows a synchronized target, from before the call moved the target so a
+    // step the last call should have taken and didn't shows up here
+    if (sync && microstepModeControl == MMC_TRACKING && error >= 0) {
+      if ((uint32_t)error > timing.positionErrorMax) timing.positionErrorMax = error;
+      if (error > 0) timing.behind++;
+    }
+  }
+#endif
+
+// set the step timer period in sub-micros, 0 stops
+void StepDirMotor::setStepPeriod(unsigned long period, bool ramp) {
+  #if STEP_DIR_PROFILER == ON
+    // expected interval between step edges in fast ticks, step timing restarts at the next edge
+    float stepTicks = (float)HAL_TICKS_PER_SECOND()*(period/16000000.0F);
+    #if STEP_WAVE_FORM == SQUARE
+      stepTicks *= 2.0F;
+    #endif
+    expectedStepTicks = (stepTicks < 4294967295.0F) ? (uint32_t)stepTicks : 0;
+    stepTimingValid = false;
+  #endif
+
+  #if STEP_DIR_SCHEDULER == ON
+    if (!ready) return;
+    #if STEP_DIR_RAMP == ON
+      if (ramp && lastPeriodSet != 0 && period != 0) {
+        // the axis owns the acceleration profile, this only spreads each change in rate over the time to the
+        // next axis poll instead of taking it as a step, in step timer callbacks per second per second
+        float rampRate = fabsf(16000000.0F/period - 16000000.0F/lastPeriodSet)*FRACTIONAL_SEC;
+        stepDirScheduler.setPeriodSubMicros(axisNumber, period, rampRate);
+        return;
+      }
+    #endif
+    stepDirScheduler.setPeriodSubMicros(axisNumber, period);
+  #else
+    UNUSED(ramp);
+    if (taskHandle) tasks.setPeriodSubMicros(taskHandle, period);
+  #endif
+}
+
+#if STEP_DIR_SCHEDULER == ON
+  // the scheduler runs each axis callback at most once a tick, and a square wave takes two callbacks per step
+  float StepDirMotor::getFrequencyLimitSteps() {
+    float limit = STEP_DIR_SCHEDULER_RATE;
+    #if STEP_WAVE_FORM == SQUARE
+      limit /= 2.0F;
+    #endif
+    return limit*getStepsPerStepSlewing();
+  }
+#endif
+
+// set the step timer callback
+void StepDirMotor::setStepCallback(void (*callback)()) {
+  callbackActive = callback;
+  #if STEP_DIR_SCHEDULER == ON
+    if (ready) stepDirScheduler.setCallback(axisNumber, callback);
+  #else
+    if (taskHandle) tasks.setCallback(taskHandle, callback);
+  #endif
+}
+
 // gard local guarantee: stop the step generator and force STEP inactive.
 void StepDirMotor::stopStepTimerAndClearPulse() {
 
@@ -373,7 +612,7 @@ void StepDirMotor::stopStepTimerAndClearPulse() {
   }
 
   // stop task first
-  if (taskHandle) tasks.setPeriodSubMicros(taskHandle, 0);
+  setStepPeriod(0);
 
   // clear bookkeeping
   lastPeriod = 0;
@@ -392,7 +631,7 @@ void StepDirMotor::stopStepTimerAndClearPulse() {
 
 // clears backlash/state, sets microstep tracking, etc.
 void StepDirMotor::resetToTrackingBaseline() {
-  if (taskHandle) tasks.setCallback(taskHandle, callback);
+  setStepCallback(callback);
 
   noInterrupts();
   // clear any pending synthetic motion state
@@ -407,6 +646,9 @@ void StepDirMotor::resetToTrackingBaseline() {
 
   microstepModeControl = MMC_TRACKING;
   stepSize = 1;
+  #if STEP_DIR_MICROSTEP_LEVELS == ON
+    stepSizeRequest = 0;
+  #endif
 
   #if defined(GPIO_DIRECTION_PINS)
     if (direction > DirNone) updateMotorDirection();
@@ -441,7 +683,7 @@ IRAM_ATTR void StepDirMotor::move(const int16_t stepPin) {
     if (direction > DirNone) return;
   #endif
 
-  if (microstepModeControl == MMC_SLEWING_REQUEST && (motorSteps + backlashSteps) % driver->getMicrostepRatio() == 0 && direction < DirNone) {
+  if (microstepModeControl == MMC_SLEWING_REQUEST && (motorSteps + backlashSteps + backlashSkewSteps) % driver->getMicrostepRatio() == 0 && direction < DirNone) {
     microstepModeControl = MMC_SLEWING_PAUSE;
     tasks.immediate(monitorHandle);
   }
@@ -466,6 +708,12 @@ IRAM_ATTR void StepDirMotor::move(const int16_t stepPin) {
       return;
     }
 
+    // with a smaller reverse amount takeup starts part way into the backlash travel
+    if (backlashSteps > backlashReverseStart) {
+      backlashSkewSteps += backlashSteps - backlashReverseStart;
+      backlashSteps = backlashReverseStart;
+    }
+
     if (backlashSteps > 0) {
       backlashSteps--;
       inBacklash = backlashSteps > 0;
@@ -492,6 +740,12 @@ IRAM_ATTR void StepDirMotor::move(const int16_t stepPin) {
       return;
     }
 
+    // with a smaller forward amount takeup starts part way into the backlash travel
+    if (backlashSteps < backlashForwardStart) {
+      backlashSkewSteps -= backlashForwardStart - backlashSteps;
+      backlashSteps = backlashForwardStart;
+    }
+
     if (backlashSteps < backlashAmountSteps) {
       backlashSteps++;
       inBacklash = backlashSteps < backlashAmountSteps;
@@ -513,11 +767,80 @@ IRAM_ATTR void StepDirMotor::move(const int16_t stepPin) {
   #endif
 }
 
+IRAM_ATTR void StepDirMotor::moveT(const int16_t stepPin) {
+  #if STEP_WAVE_FORM == PULSE
+    digitalWriteF(stepPin, stepClr);
+  #endif
+
+  #ifdef GPIO_DIRECTION_PINS
+    if (direction > DirNone) return;
+  #endif
+
+  #if STEP_WAVE_FORM == SQUARE
+    if (takeStep) {
+  #endif
+
+  long lastTargetSteps = targetSteps;
+  if (sync) targetSteps += step;
+
+  if (motorSteps > targetSteps) {
+    if (direction != dirRev) {
+      targetSteps = lastTargetSteps;
+      #ifdef GPIO_DIRECTION_PINS
+        direction = DirSetRev;
+      #else
+        direction = dirRev;
+        digitalWriteF(Pins->dir, dirRev);
+      #endif
+      return;
+    }
+
+    motorSteps--;
+
+    #ifdef SHARED_DIRECTION_PINS
+      if (axisNumber > 2) { digitalWriteF(Pins->dir, direction); delayNanoseconds(pulseWidth); }
+    #endif
+    digitalWriteF(stepPin, stepSet);
+  } else
+
+  if (motorSteps < targetSteps) {
+    if (direction != dirFwd) {
+      targetSteps = lastTargetSteps;
+      #ifdef GPIO_DIRECTION_PINS
+        direction = DirSetFwd;
+      #else
+        direction = dirFwd;
+        digitalWriteF(Pins->dir, dirFwd);
+      #endif
+      return;
+    }
+
+    motorSteps++;
+
+    #ifdef SHARED_DIRECTION_PINS
+      if (axisNumber > 2) { digitalWriteF(Pins->dir, direction); delayNanoseconds(pulseWidth); }
+    #endif
+    digitalWriteF(stepPin, stepSet);
+
+  } else direction = DirNone;
+
+  #if STEP_WAVE_FORM == SQUARE
+    } else digitalWriteF(stepPin, stepClr);
+    takeStep = !takeStep;
+  #endif
+}
+
 IRAM_ATTR void StepDirMotor::moveFF(const int16_t stepPin) {
   #if STEP_WAVE_FORM == PULSE
     digitalWriteF(stepPin, stepClr);
   #endif
 
+  #if STEP_DIR_MICROSTEP_LEVELS == ON
+    if (stepSizeRequest != 0 && microstepModeControl == MMC_SLEWING && (motorSteps + backlashSteps + backlashSkewSteps) % stepSizeRequest == 0) {
+      microstepModeControl = MMC_SLEWING_PAUSE;
+      tasks.immediate(monitorHandle);
+    }
+  #endif
   if (microstepModeControl >= MMC_SLEWING_PAUSE) return;
 
   #if STEP_WAVE_FORM == SQUARE
@@ -546,6 +869,12 @@ IRAM_ATTR void StepDirMotor::moveFR(const int16_t stepPin) {
     digitalWriteF(stepPin, stepClr);
   #endif
 
+  #if STEP_DIR_MICROSTEP_LEVELS == ON
+    if (stepSizeRequest != 0 && microstepModeControl == MMC_SLEWING && (motorSteps + backlashSteps + backlashSkewSteps) % stepSizeRequest == 0) {
+      microstepModeControl = MMC_SLEWING_PAUSE;
+      tasks.immediate(monitorHandle);
+    }
+  #endif
   if (microstepModeControl >= MMC_SLEWING_PAUSE) return;
 
   #if STEP_WAVE_FORM == SQUARE
@@ -12,6 +12,8 @@
 
 #include "../../../gpioEx/GpioEx.h"
 
+#include "StepDirScheduler.h"
+
 #include "generic/Generic.h"
 #include "tmc/legacy/tmc2130/Tmc2130.h"
 #include "tmc/legacy/tmc2209/Tmc2209.h"
@@ -33,6 +35,39 @@ typedef struct StepDirPins {
   uint8_t enabledState;
 } StepDirPins;
 
+#ifndef STEP_DIR_MICROSTEP_LEVELS
+#define STEP_DIR_MICROSTEP_LEVELS OFF
+#endif
+#ifndef STEP_DIR_MICROSTEP_LEVEL_RATE
+#define STEP_DIR_MICROSTEP_LEVEL_RATE 10000
+#endif
+
+#ifndef STEP_DIR_PROFILER
+#define STEP_DIR_PROFILER OFF
+#endif
+
+#if STEP_DIR_PROFILER == ON
+  #define STEP_DIR_ISR_MOVE 0
+  #define STEP_DIR_ISR_MOVE_FF 1
+  #define STEP_DIR_ISR_MOVE_FR 2
+  #define STEP_DIR_ISR_MOVE_T 3
+
+  typedef struct StepDirIsrProfile {
+    uint32_t min;
+    uint32_t max;
+    uint32_t count;
+    uint64_t total;
+  } StepDirIsrProfile;
+
+  typedef struct StepDirTiming {
+    uint32_t steps;            // step edges timed against the commanded rate
+    uint32_t jitterMax;        // in fast ticks
+    uint64_t jitterTotal;
+    uint32_t positionErrorMax; // in steps, while tracking a synchronized target
+    uint32_t behind;           // ISR calls that started with the motor away from its synchronized target
+  } StepDirTiming;
+#endif
+
 #define DirNone 253
 #define DirSetRev 254
 #define DirSetFwd 255
@@ -81,12 +116,26 @@ class StepDirMotor : public Motor {
     // set frequency (+/-) in steps per second negative frequencies move reverse in direction (0 stops motion)
     void setFrequencySteps(float frequency);
 
+    // set backlash amount in steps, each direction can have its own amount
+    // \param value: backlash taken up on reversals toward forward
+    // \param valueReverse: backlash taken up on reversals toward reverse, -1 for the same as value
+    void setBacklashSteps(long value, long valueReverse = -1);
+
+    // request backlash takeup toward direction (1 or -1) ahead of an anticipated reversal, this starts
+    // once the motor is stopped at its target in tracking mode
+    void setBacklashPreload(int8_t direction) { backlashPreload = direction; }
+
     // sets overall maximum frequency
     // \param frequency: rate of motion in steps (counts) per second
     void setFrequencyMax(float frequency) {
       driver->setFrequencyMax(frequency);
     }
 
+    #if STEP_DIR_SCHEDULER == ON
+      // get the highest frequency the step scheduler can move the motor at, in steps per second
+      float getFrequencyLimitSteps();
+    #endif
+
     // get tracking mode steps per slewing mode step
     inline int getStepsPerStepSlewing() { return driver->getMicrostepRatio(); }
 
@@ -102,6 +151,23 @@ class StepDirMotor : public Motor {
     // get live StallGuard telemetry if supported
     bool getStallGuardTelemetry(char *reply, size_t replySize) { return driver->getStallGuardTelemetry(reply, replySize); }
 
+    #if STEP_DIR_PROFILER == ON
+      // get step ISR cost in fast ticks as min,avg,max for move, moveFF, moveFR, and moveT since the last call
+      bool getIsrProfile(char *reply, size_t replySize);
+
+      // get step timing accuracy since the last call as steps,avg jitter,max jitter (in fast ticks),max position error,calls behind target
+      bool getStepTiming(char *reply, size_t replySize);
+
+      // step position before an ISR call, for profile()
+      inline long profilePosition() { return motorSteps + backlashSteps; }
+
+      // steps the motor is from its target before an ISR call, for profile(), -1 while in backlash
+      inline long profileError() { return inBacklash ? -1 : labs(targetSteps - motorSteps); }
+
+      // record the cost and step timing of one step ISR call started at t0 (in fast ticks), from the ISR
+      void profile(uint8_t isr, uint32_t t0, long position, long error);
+    #endif
+
     // calibrate stealthChop then return to tracking mode
     void calibrateDriver() {
       if (!ready) return;
@@ -121,6 +187,9 @@ class StepDirMotor : public Motor {
     // sets dir as required and moves coord toward target at setFrequencySteps() rate
     void move(const int16_t stepPin);
 
+    // tracking axis movement, no backlash, no mode switching
+    void moveT(const int16_t stepPin);
+
     // fast forward axis movement, no backlash, no mode switching
     void moveFF(const int16_t stepPin);
 
@@ -140,13 +209,29 @@ class StepDirMotor : public Motor {
     // switch microstep modes as needed
     void modeSwitch();
 
+    #if STEP_DIR_MICROSTEP_LEVELS == ON
+      // get the slewing step size (in tracking mode steps) for this frequency in tracking mode steps per second
+      int microstepLevel(float frequency);
+    #endif
+
     // swaps in/out fast unidirectional ISR for slewing 
     bool enableMoveFast(const bool state);
 
+    // set the step timer period in sub-micros, 0 stops
+    // \param ramp: true to reach the period gradually over one axis poll from the last period set, if supported
+    void setStepPeriod(unsigned long period, bool ramp = false);
+
+    // set the step timer callback
+    void setStepCallback(void (*callback)());
+
     void stopStepTimerAndClearPulse();
 
     void resetToTrackingBaseline();
 
+    // start taking up backlash toward direction (1 or -1) while stopped at the target
+    // returns false if the motor isn't stopped at its target yet
+    bool backlashPreloadStart(int8_t direction);
+
     uint8_t taskHandle = 0;
 
     #ifdef DRIVER_STEP_DEFAULTS
@@ -162,8 +247,16 @@ class StepDirMotor : public Motor {
     volatile uint32_t pulseWidth = 2000; // step/dir driver pulse width in nanoseconds
 
     volatile int16_t stepSize = 1;       // step size during slews (for microstep mode switching)
+    #if STEP_DIR_MICROSTEP_LEVELS == ON
+      volatile int16_t stepSizeRequest = 0; // step size to change to at the next boundary while slewing, 0 for none
+    #endif
     volatile bool takeStep = false;      // should we take a step
 
+    int8_t backlashPreload = 0;          // requested backlash takeup direction ahead of a reversal, 0 for none
+    volatile long backlashSkewSteps = 0; // driver steps less backlash travel counted, from uneven takeup amounts
+    volatile uint16_t backlashForwardStart = 0; // backlash position takeup toward forward starts from
+    volatile uint16_t backlashReverseStart = 0; // backlash position takeup toward reverse starts from
+
     float currentFrequency = 0.0F;       // last frequency set 
     float lastFrequency = 0.0F;          // last frequency requested in tracking mode microsteps per second
     unsigned long lastPeriod = 0;        // last timer period (in sub-micros)
@@ -174,9 +267,19 @@ class StepDirMotor : public Motor {
 
     bool useFastHardwareTimers = true;
 
+    #if STEP_DIR_PROFILER == ON
+      StepDirIsrProfile isrProfile[4] = {{UINT32_MAX, 0, 0, 0}, {UINT32_MAX, 0, 0, 0}, {UINT32_MAX, 0, 0, 0}, {UINT32_MAX, 0, 0, 0}};
+      StepDirTiming timing = {0, 0, 0, 0, 0};
+      volatile uint32_t expectedStepTicks = 0;
+      volatile bool stepTimingValid = false;
+      uint32_t lastStepTicks = 0;
+    #endif
+
     void (*callback)() = NULL;
+    void (*callbackT)() = NULL;
     void (*callbackFF)() = NULL;
     void (*callbackFR)() = NULL;
+    void (*callbackActive)() = NULL;
 };
 
 #endif
@@ -53,6 +53,13 @@ class StepDirDriver {
     // set microstep mode for slewing
     virtual int modeMicrostepSlewing() { return 1; }
 
+    // set microstep mode for slewing at an intermediate resolution (slewing to tracking microsteps)
+    // returns tracking mode steps per step at that resolution, or 0 if not supported
+    virtual int modeMicrostepLevel(int microsteps) { UNUSED(microsteps); return 0; }
+
+    // true if modeMicrostepLevel() is supported
+    virtual bool hasMicrostepLevels() const { return false; }
+
     // set decay mode for tracking
     virtual void modeDecayTracking() {}
 
@@ -0,0 +1,162 @@
+// -----------------------------------------------------------------------------------
+// axis step/dir motor, shared step scheduler
+
+#include "StepDirScheduler.h"
+
+#if defined(STEP_DIR_MOTOR_PRESENT) && STEP_DIR_SCHEDULER == ON
+
+#include "../../../tasks/OnTask.h"
+
+IRAM_ATTR void stepDirSchedulerWrapper() { stepDirScheduler.poll(); }
+
+bool StepDirScheduler::init() {
+  if (ready) return true;
+
+  VF("MSG: StepDir, start step scheduler task (rate "); V(STEP_DIR_SCHEDULER_RATE); VF("Hz)... ");
+  taskHandle = tasks.add(0, 0, true, 0, stepDirSchedulerWrapper, "StpSchd");
+  if (!taskHandle) { VLF("FAILED!"); return false; }
+  if (!tasks.requestHardwareTimer(taskHandle, 0)) { VLF("FAILED, no hardware timer!"); tasks.remove(taskHandle); taskHandle = 0; return false; }
+  VLF("success");
+
+  tasks.setPeriodSubMicros(taskHandle, lround(16000000.0/STEP_DIR_SCHEDULER_RATE));
+
+  ready = true;
+  return true;
+}
+
+void StepDirScheduler::setCallback(uint8_t axisNumber, void (*callback)()) {
+  if (axisNumber < 1 || axisNumber > STEP_DIR_SCHEDULER_SLOTS) return;
+  slot[axisNumber - 1].callback = callback;
+  if (axisNumber > slotCount) slotCount = axisNumber;
+}
+
+void StepDirScheduler::setPeriodSubMicros(uint8_t axisNumber, unsigned long period) {
+  if (axisNumber < 1 || axisNumber > STEP_DIR_SCHEDULER_SLOTS) return;
+
+  uint32_t increment = periodToIncrement(period);
+  StepDirSchedulerSlot *s = &slot[axisNumber - 1];
+  noInterrupts();
+  #if MOTION_GROUP == ON
+    // a stop isn't held back, and it also drops any held rate so release() can't restart the axis
+    if (s->held && increment != 0) { holdRate(s, increment, 0, true); interrupts(); return; }
+    s->pending = false;
+  #endif
+  #if STEP_DIR_RAMP == ON
+    s->rampDelta = 0;
+    s->target = increment;
+  #endif
+  s->increment = increment;
+  interrupts();
+}
+
+#if STEP_DIR_RAMP == ON
+  void StepDirScheduler::setPeriodSubMicros(uint8_t axisNumber, unsigned long period, float rampRate) {
+    if (axisNumber < 1 || axisNumber > STEP_DIR_SCHEDULER_SLOTS) return;
+
+    // change in callbacks per second each tick, as a fraction of 2^32 callbacks per tick
+    double delta = (rampRate/((double)STEP_DIR_SCHEDULER_RATE*STEP_DIR_SCHEDULER_RATE))*4294967296.0;
+    uint32_t rampDelta = (delta >= 4294967295.0) ? 0xFFFFFFFFUL : (uint32_t)delta;
+    if (rampDelta == 0) rampDelta = 1;
+
+    StepDirSchedulerSlot *s = &slot[axisNumber - 1];
+    uint32_t increment = periodToIncrement(period);
+    noInterrupts();
+    #if MOTION_GROUP == ON
+      if (s->held) { holdRate(s, increment, rampDelta, false); interrupts(); return; }
+      s->pending = false;
+    #endif
+    s->rampDelta = rampDelta;
+    s->target = increment;
+    interrupts();
+  }
+#endif
+
+#if MOTION_GROUP == ON
+  void StepDirScheduler::hold(uint16_t axisMask) {
+    if (!ready) return;
+    for (uint8_t i = 0; i < STEP_DIR_SCHEDULER_SLOTS; i++) if (bitRead(axisMask, i)) slot[i].held = true;
+  }
+
+  void StepDirScheduler::release() {
+    // copied in one critical section so the ISR sees all the new rates on the same tick
+    noInterrupts();
+    for (uint8_t i = 0; i < STEP_DIR_SCHEDULER_SLOTS; i++) {
+      StepDirSchedulerSlot *s = &slot[i];
+      if (!s->held) continue;
+      s->held = false;
+      if (!s->pending) continue;
+      #if STEP_DIR_RAMP == ON
+        s->target = s->pendingTarget;
+        s->rampDelta = s->pendingRampDelta;
+        if (s->pendingJump) s->increment = s->pendingTarget;
+      #else
+        s->increment = s->pendingTarget;
+      #endif
+      s->pending = false;
+    }
+    interrupts();
+  }
+
+  void StepDirScheduler::holdRate(StepDirSchedulerSlot *s, uint32_t target, uint32_t rampDelta, bool jump) {
+    s->pendingTarget = target;
+    s->pendingRampDelta = rampDelta;
+    s->pendingJump = jump;
+    s->pending = true;
+  }
+#endif
+
+uint32_t StepDirScheduler::periodToIncrement(unsigned long period) {
+  // rates at or above the tick rate run every tick
+  if (period == 0) return 0;
+  double fraction = (16000000.0/STEP_DIR_SCHEDULER_RATE)/period;
+  if (fraction >= 1.0) return 0xFFFFFFFFUL;
+  return (uint32_t)(fraction*4294967296.0);
+}
+
+IRAM_ATTR void StepDirScheduler::poll() {
+  for (uint8_t i = 0; i < slotCount; i++) {
+        StepDirSchedulerSlot *s = &slot[i];
+        if (!s->pending) continue;
+        #if STEP_DIR_RAMP == ON
+          s->target = s->pendingTarget;
+          s->rampDelta = s->pendingRampDelta;
+          if (s->pendingJump) s->increment = s->pendingTarget;
+        #else
+          s->increment = s->pendingTarget;
+        #endif
+        s->pending = false;
+      }
+      swap = false;
+    }
+  #endif
+
+  for (uint8_t i = 0; i < slotCount; i++) {
+    StepDirSchedulerSlot *s = &slot[i];
+    uint32_t increment = s->increment;
+
+    #if STEP_DIR_RAMP == ON
+      // ramp toward the target rate, the change is spread over every tick instead of once per axis poll
+      uint32_t target = s->target;
+      if (increment != target) {
+        uint32_t rampDelta = s->rampDelta;
+        if (increment < target) {
+          if (rampDelta == 0 || target - increment <= rampDelta) increment = target; else increment += rampDelta;
+        } else {
+          if (rampDelta == 0 || increment - target <= rampDelta) increment = target; else increment -= rampDelta;
+        }
+        s->increment = increment;
+      }
+    #endif
+
+    if (increment == 0) continue;
+
+    uint32_t accumulator = s->accumulator + increment;
+    bool carry = accumulator < increment;
+    s->accumulator = accumulator;
+    if (carry && s->callback != NULL) s->callback();
+  }
+}
+
+StepDirScheduler stepDirScheduler;
+
+#endif
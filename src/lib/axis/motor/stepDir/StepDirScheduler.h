@@ -0,0 +1,101 @@
+// -----------------------------------------------------------------------------------
+// axis step/dir motor, shared step scheduler
+#pragma once
+
+#include "../../../../Common.h"
+
+#ifdef STEP_DIR_MOTOR_PRESENT
+
+#ifndef STEP_DIR_SCHEDULER
+#define STEP_DIR_SCHEDULER OFF
+#endif
+
+#if STEP_DIR_SCHEDULER == ON
+
+#ifndef STEP_DIR_SCHEDULER_RATE
+#define STEP_DIR_SCHEDULER_RATE 40000
+#endif
+
+#ifndef STEP_DIR_RAMP
+#define STEP_DIR_RAMP OFF
+#endif
+
+#ifndef MOTION_GROUP
+#define MOTION_GROUP OFF
+#endif
+
+#ifdef HAL_SLOW_PROCESSOR
+  #error "Configuration (Config.h): STEP_DIR_SCHEDULER ON isn't supported on this processor"
+#endif
+
+#define STEP_DIR_SCHEDULER_SLOTS 9
+
+typedef struct StepDirSchedulerSlot {
+  volatile uint32_t increment;   // phase added each tick, a carry out of the accumulator runs the callback
+  volatile uint32_t accumulator;
+  #if STEP_DIR_RAMP == ON
+    volatile uint32_t target;    // increment the ramp is moving toward
+    volatile uint32_t rampDelta; // increment change per tick, 0 to jump straight to the target
+  #endif
+  #if MOTION_GROUP == ON
+    volatile bool held;          // true while a motion group holds this axis' rate changes
+    volatile bool pending;       // true if the pending values below are waiting for release()
+    uint32_t pendingTarget;
+    uint32_t pendingRampDelta;
+    bool pendingJump;            // true to set the increment to the target immediately
+  #endif
+  void (* volatile callback)();
+} StepDirSchedulerSlot;
+
+// steps all step/dir axes from one hardware timer, each axis has a DDA (phase accumulator)
+// so its step rate is independent of the others and of the task scheduler
+class StepDirScheduler {
+  public:
+    // start the scheduler timer, only the first call does anything
+    bool init();
+
+    // set the callback for an axis (1 to 9)
+    void setCallback(uint8_t axisNumber, void (*callback)());
+
+    // set the callback period for an axis (1 to 9) in sub-micros, 0 stops
+    void setPeriodSubMicros(uint8_t axisNumber, unsigned long period);
+
+    #if STEP_DIR_RAMP == ON
+      // set the callback period for an axis (1 to 9) in sub-micros, reached by changing the
+      // callback rate at most rampRate (in callbacks per second per second) each tick
+      void setPeriodSubMicros(uint8_t axisNumber, unsigned long period, float rampRate);
+    #endif
+
+    #if MOTION_GROUP == ON
+      // period changes for these axes are held back until release(), stops still take effect immediately
+      // \param axisMask: bit 0 for axis 1, bit 1 for axis 2, etc.
+      void hold(uint16_t axisMask);
+
+      // apply the period changes held since hold() together, they take effect on the same tick
+      void release();
+    #endif
+
+    // run any callbacks that are due, from the timer ISR
+    void poll();
+
+  private:
+    #if MOTION_GROUP == ON
+      // keep a period change for release()
+      void holdRate(StepDirSchedulerSlot *s, uint32_t target, uint32_t rampDelta, bool jump);
+    #endif
+
+    // callbacks per tick as a fraction of 2^32
+    uint32_t periodToIncrement(unsigned long period);
+
+    StepDirSchedulerSlot slot[STEP_DIR_SCHEDULER_SLOTS] = {};
+    volatile uint8_t slotCount = 0;
+
+    uint8_t taskHandle = 0;
+    bool ready = false;
+};
+
+extern StepDirScheduler stepDirScheduler;
+
+#endif
+
+#endif
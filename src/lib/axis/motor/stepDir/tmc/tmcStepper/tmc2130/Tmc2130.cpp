@@ -75,6 +75,12 @@ int StepDirTmc2130::modeMicrostepSlewing() {
   return microstepRatio;
 }
 
+int StepDirTmc2130::modeMicrostepLevel(int microsteps) {
+  if (microsteps < normalizedMicrostepsSlewing || microsteps > normalizedMicrosteps) return 0;
+  driver->microsteps(microsteps);
+  return normalizedMicrosteps/microsteps;
+}
+
 void StepDirTmc2130::modeDecayTracking() {
   setDecayMode(decay.value);
   current(iRun, iHoldRatio);
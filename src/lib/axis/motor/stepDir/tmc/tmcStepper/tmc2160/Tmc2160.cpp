@@ -79,6 +79,12 @@ int Tmc2160StepDirDriver::modeMicrostepSlewing() {
   return microstepRatio;
 }
 
+int Tmc2160StepDirDriver::modeMicrostepLevel(int microsteps) {
+  if (microsteps < normalizedMicrostepsSlewing || microsteps > normalizedMicrosteps) return 0;
+  driver->microsteps(microsteps);
+  return normalizedMicrosteps/microsteps;
+}
+
 void Tmc2160StepDirDriver::modeDecayTracking() {
   setDecayMode(decay.value);
   current(iRun, iHoldRatio);
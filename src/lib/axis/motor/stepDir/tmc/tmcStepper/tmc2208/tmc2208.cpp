@@ -95,6 +95,12 @@ int StepDirTmc2208::modeMicrostepSlewing() {
   return microstepRatio;
 }
 
+int StepDirTmc2208::modeMicrostepLevel(int microsteps) {
+  if (microsteps < normalizedMicrostepsSlewing || microsteps > normalizedMicrosteps) return 0;
+  if (microsteps == 1) driver->microsteps(0); else driver->microsteps(microsteps);
+  return normalizedMicrosteps/microsteps;
+}
+
 void StepDirTmc2208::modeDecayTracking() {
   setDecayMode(decay.value);
   current(iRun, iHoldRatio);
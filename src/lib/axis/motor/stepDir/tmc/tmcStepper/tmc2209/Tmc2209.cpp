@@ -123,6 +123,12 @@ int StepDirTmc2209::modeMicrostepSlewing() {
   return microstepRatio;
 }
 
+int StepDirTmc2209::modeMicrostepLevel(int microsteps) {
+  if (microsteps < normalizedMicrostepsSlewing || microsteps > normalizedMicrosteps) return 0;
+  if (microsteps == 1) driver->microsteps(0); else driver->microsteps(microsteps);
+  return normalizedMicrosteps/microsteps;
+}
+
 void StepDirTmc2209::modeDecayTracking() {
   setDecayMode(decay.value);
   current(iRun, iHoldRatio);
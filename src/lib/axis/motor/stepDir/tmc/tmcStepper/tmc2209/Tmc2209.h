@@ -26,6 +26,10 @@ class StepDirTmc2209 : public TmcStepDirDriverSG {
     // set microstep mode for slewing
     int modeMicrostepSlewing();
 
+    // set microstep mode for slewing at an intermediate resolution, returns tracking mode steps per step
+    int modeMicrostepLevel(int microsteps);
+    bool hasMicrostepLevels() const { return true; }
+
     // set decay mode for tracking
     void modeDecayTracking();
 
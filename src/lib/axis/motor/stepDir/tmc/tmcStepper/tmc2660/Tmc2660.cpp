@@ -67,6 +67,12 @@ int StepDirTmc2660::modeMicrostepSlewing() {
   return microstepRatio;
 }
 
+int StepDirTmc2660::modeMicrostepLevel(int microsteps) {
+  if (microsteps < normalizedMicrostepsSlewing || microsteps > normalizedMicrosteps) return 0;
+  driver->microsteps(microsteps);
+  return normalizedMicrosteps/microsteps;
+}
+
 void StepDirTmc2660::modeDecayTracking() {
   current(iRun);
 }
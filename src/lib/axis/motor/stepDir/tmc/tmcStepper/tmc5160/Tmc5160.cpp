@@ -75,6 +75,12 @@ int StepDirTmc5160::modeMicrostepSlewing() {
   return microstepRatio;
 }
 
+int StepDirTmc5160::modeMicrostepLevel(int microsteps) {
+  if (microsteps < normalizedMicrostepsSlewing || microsteps > normalizedMicrosteps) return 0;
+  driver->microsteps(microsteps);
+  return normalizedMicrosteps/microsteps;
+}
+
 void StepDirTmc5160::modeDecayTracking() {
   setDecayMode(decay.value);
   current(iRun, iHoldRatio);
@@ -75,6 +75,12 @@ int StepDirTmc5161::modeMicrostepSlewing() {
   return microstepRatio;
 }
 
+int StepDirTmc5161::modeMicrostepLevel(int microsteps) {
+  if (microsteps < normalizedMicrostepsSlewing || microsteps > normalizedMicrosteps) return 0;
+  driver->microsteps(microsteps);
+  return normalizedMicrosteps/microsteps;
+}
+
 void StepDirTmc5161::modeDecayTracking() {
   setDecayMode(decay.value);
   current(iRun, iHoldRatio);
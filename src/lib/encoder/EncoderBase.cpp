@@ -9,6 +9,10 @@
 #include "Arduino.h"
 #include "../tasks/OnTask.h"
 
+#if ENCODER_CORRECTION == ON
+  #include "../nv/Nv.h"
+#endif
+
 Encoder *encoder[9];
 
 void encoderCallback1() { encoder[0]->poll(); }
@@ -71,106 +75,135 @@ bool Encoder::init() {
   #if ENCODER_VELOCITY == ON
     velTicksPerSec = HAL_TICKS_PER_SECOND();
 
-    // Cache stop timeout (us) converted to ticks (avoids 64-bit math in readVelocityCps())
+    // Cache stop timeout and window length (us) converted to ticks (avoids 64-bit math in readVelocityCps())
     uint64_t stopTicks64 = (uint64_t)ENCODER_VEL_STOP_US * (uint64_t)velTicksPerSec;
     stopTicks64 = (stopTicks64 + 500000ULL) / 1000000ULL;     // rounded divide by 1e6
     if (stopTicks64 > 0x7FFFFFFFULL) stopTicks64 = 0x7FFFFFFFULL;
     velStopTicks = (uint32_t)stopTicks64;
 
+    uint64_t windowTicks64 = (uint64_t)ENCODER_VEL_WINDOW_US * (uint64_t)velTicksPerSec;
+    windowTicks64 = (windowTicks64 + 500000ULL) / 1000000ULL;
+    if (windowTicks64 > 0x7FFFFFFFULL) windowTicks64 = 0x7FFFFFFFULL;
+    velWindowTicks = (uint32_t)windowTicks64;
+
+    // critically damped tracking observer
+    velPllWn = 2.0F*(float)PI*ENCODER_VEL_PLL_HZ;
+
     velLastEdgeTicks   = 0;
     velLastPeriodTicks = 0;
+    velEdgeCount       = 0;
     velLastDir         = 0;
 
-    velWinLastCount = (int32_t)count;
-    velWinLastUs    = 0;
-    velBlendCps     = NAN;
+    velWinStarted  = false;
+    velWindowCps   = NAN;
+    velPllInit     = false;
+    velBlendCps    = NAN;
     velHasEstimate = false;
   #endif
 
   return true;
 }
 
-float Encoder::readVelocityCps() {
+// the estimate comes from one of three methods depending on how many counts arrive per window:
+// under one the latest edge period, over ENCODER_VEL_BLEND_COUNTS the count over an edge to edge
+// window, and in between a phase-locked tracking observer of the count, with a cross-fade at each change
+IRAM_ATTR float Encoder::readVelocityCps() {
   #if ENCODER_VELOCITY != ON
     return NAN;
   #else
 
   // snapshot state (safe if velLast* can be updated from ISR)
   uint32_t lastEdgeTicks, lastPeriodTicks;
+  int32_t  edgeCountSnap, countSnap;
   int8_t   dirSnap;
-  int32_t  countSnap;
 
   noInterrupts();
   lastEdgeTicks   = velLastEdgeTicks;
   lastPeriodTicks = velLastPeriodTicks;
+  edgeCountSnap   = velEdgeCount;
   dirSnap         = velLastDir;
   countSnap       = count;
   interrupts();
 
-  // cached stop timeout (ticks) computed once in init()
-  const uint32_t nowTicks  = HAL_FAST_TICKS();
-  const uint32_t stopTicks = velStopTicks;
-
+  const uint32_t nowTicks = HAL_FAST_TICKS();
   const uint32_t ageTicks = nowTicks - lastEdgeTicks;
-  const bool stale = (lastEdgeTicks == 0) || (ageTicks > stopTicks);
-
-  // (A) period/reciprocal estimate (best at low speed)
-  float v_per = NAN;
-  if (!stale && lastPeriodTicks != 0 && dirSnap != 0) {
-    v_per = (dirSnap > 0 ? 1.0F : -1.0F) * ((float)velTicksPerSec / (float)lastPeriodTicks);
-  }
-
-  // (B) windowed count estimate (best at higher speed)
-  const uint32_t nowUs = micros();
-  if (velWinLastUs == 0) {
-    velWinLastUs    = nowUs;
-    velWinLastCount = countSnap;
-
-    // if we already have a period estimate, expose it immediately (low-speed friendly)
-    if (!isnan(v_per)) {
-      velBlendCps    = v_per;
-      velHasEstimate = true;
-      return velBlendCps;
+  const bool stale = (lastEdgeTicks == 0) || (ageTicks > velStopTicks);
+
+  // (C) tracking observer, advanced every call so it follows the count between edges
+  if (!velPllInit || stale) {
+    velPllInit      = true;
+    velPllBase      = countSnap;
+    velPllPos       = 0.0F;
+    velPllCps       = 0.0F;
+    velPllLastTicks = nowTicks;
+  } else {
+    const float dt = (float)(nowTicks - velPllLastTicks)/(float)velTicksPerSec;
+    if (dt > 0.0F) {
+      velPllLastTicks = nowTicks;
+
+      // predict, then correct with the gains that put a double pole at exp(-wn*dt), worked out for each
+      // sample so the observer is critically damped and stable at any bandwidth and read interval
+      velPllPos += velPllCps*dt;
+      const float p = expf(-velPllWn*dt);
+      const float e = (float)(countSnap - velPllBase) - velPllPos;
+      velPllPos += (1.0F - p*p)*e;
+      velPllCps += ((1.0F - p)*(1.0F - p)/dt)*e;
+
+      // keep the fractional position small so it doesn't lose float precision
+      const int32_t whole = (int32_t)velPllPos;
+      velPllBase += whole;
+      velPllPos  -= whole;
     }
-
-    // otherwise: no usable estimate yet.
-    return NAN;
   }
 
-  const uint32_t dtUs = nowUs - velWinLastUs;
-  const int32_t  dc   = countSnap - velWinLastCount;
-
-  if (dtUs >= (uint32_t)ENCODER_VEL_WINDOW_US) {
-    const float v_cnt = (dtUs != 0) ? (dc*(1000000.0F/(float)dtUs)) : 0.0F;
-
-    // if period estimate is unavailable, do NOT bias toward 0; use v_cnt directly
-    if (isnan(v_per)) {
-      velBlendCps = v_cnt;
-    } else {
-      float a = fabsf((float)dc) / (float)ENCODER_VEL_BLEND_COUNTS;
-      if (a < 0.0F) a = 0.0F;
-      if (a > 1.0F) a = 1.0F;
-      velBlendCps = a * v_cnt + (1.0F - a) * v_per;
-    }
+  // stop timeout means stop timeout (once we have any estimate)
+  if (stale) {
+    velWinStarted = false;
+    velWindowCps  = NAN;
+    if (velHasEstimate) velBlendCps = 0.0F;
+    return velBlendCps;
+  }
 
-    velHasEstimate = true;
+  // (A) period/reciprocal estimate (best at low speed), a wait longer than the last period
+  // already says the axis is slower than that
+  float v_per = NAN;
+  if (lastPeriodTicks != 0 && dirSnap != 0) {
+    const uint32_t periodTicks = ageTicks > lastPeriodTicks ? ageTicks : lastPeriodTicks;
+    v_per = (dirSnap > 0 ? 1.0F : -1.0F) * ((float)velTicksPerSec / (float)periodTicks);
+  }
 
-    // reset window
-    velWinLastUs    = nowUs;
-    velWinLastCount = countSnap;
+  // (B) count over time (best at higher speed), the window closes on the first edge at least
+  // ENCODER_VEL_WINDOW_US after it opened so the time is exactly that of whole counts
+  if (!velWinStarted) {
+    velWinStarted    = true;
+    velWinStartCount = edgeCountSnap;
+    velWinStartTicks = lastEdgeTicks;
   } else {
-    // before we've ever produced an estimate, allow v_per to seed velBlendCps
-    if (!velHasEstimate && !isnan(v_per)) {
-      velBlendCps    = v_per;
-      velHasEstimate = true;
+    const uint32_t winTicks = lastEdgeTicks - velWinStartTicks;
+    if (winTicks >= velWindowTicks) {
+      velWindowCps = (edgeCountSnap - velWinStartCount)*((float)velTicksPerSec/(float)winTicks);
+      velWinStartCount = edgeCountSnap;
+      velWinStartTicks = lastEdgeTicks;
     }
+  }
 
-    // stop timeout means stop timeout (once we have any estimate)
-    if (velHasEstimate && stale) {
-      velBlendCps = 0.0F;
-    }
+  // counts per window at the observer's velocity picks the method
+  const float n = fabsf(velPllCps)*(ENCODER_VEL_WINDOW_US/1000000.0F);
+  float v = velPllCps;
+  if (n < 2.0F && !isnan(v_per)) {
+    float a = n - 1.0F;
+    if (a < 0.0F) a = 0.0F;
+    v = a*velPllCps + (1.0F - a)*v_per;
+  } else
+  if (n > (float)ENCODER_VEL_BLEND_COUNTS && !isnan(velWindowCps)) {
+    float a = n/(float)ENCODER_VEL_BLEND_COUNTS - 1.0F;
+    if (a > 1.0F) a = 1.0F;
+    v = a*velWindowCps + (1.0F - a)*velPllCps;
   }
 
+  velBlendCps    = v;
+  velHasEstimate = true;
+
   return velBlendCps;
 
 #endif
@@ -225,4 +258,69 @@ void Encoder::poll() {
   }
 }
 
+#if ENCODER_CORRECTION == ON
+  // set the correction harmonics and optionally save them to NV
+  bool Encoder::setCorrection(const EncoderCorrection &harmonics, bool save) {
+    if (harmonics.countsPerTurn == 0 || harmonics.countsPerTurn != countsPerTurn()) return false;
+
+    // the table is rebuilt with the correction off so a read never sees it half done
+    correctionReady = false;
+    correction = harmonics;
+
+    const int entries = 1 << ENCODER_CORRECTION_LUT_BITS;
+    float minimum = 0.0F;
+    float maximum = 0.0F;
+    for (int i = 0; i < entries; i++) {
+      const float angle = (2.0F*(float)PI*i)/entries;
+      float error = 0.0F;
+      for (int k = 0; k < ENCODER_CORRECTION_HARMONICS; k++) {
+        error += correction.cosine[k]*cosf((k + 1)*angle) + correction.sine[k]*sinf((k + 1)*angle);
+      }
+      if (error > 1048576.0F) error = 1048576.0F; else if (error < -1048576.0F) error = -1048576.0F;
+      if (error < minimum) minimum = error;
+      if (error > maximum) maximum = error;
+      correctionLut[i] = lroundf(error*16.0F);
+    }
+    correctionLut[entries] = correctionLut[0];
+    correctionScale = (1ULL << (40 + ENCODER_CORRECTION_LUT_BITS))/correction.countsPerTurn;
+
+    correctionReady = true;
+
+    VF("MSG: Encoder"); V(axis); VF(", correction +/- "); V((maximum - minimum)/2.0F); VLF(" counts");
+
+    if (save) {
+      char keyStr[20];
+      snprintf(keyStr, sizeof(keyStr), "AXIS%u_ENC_CORR", (unsigned)axis);
+      nv().kv().put(nv().kv().computeKey(keyStr), correction);
+    }
+
+    return true;
+  }
+
+  // forget the correction, also in NV
+  void Encoder::clearCorrection() {
+    correctionReady = false;
+    correction.countsPerTurn = 0;
+
+    char keyStr[20];
+    snprintf(keyStr, sizeof(keyStr), "AXIS%u_ENC_CORR", (unsigned)axis);
+    nv().kv().del(nv().kv().computeKey(keyStr));
+
+    VF("MSG: Encoder"); V(axis); VLF(", correction cleared");
+  }
+
+  // read the correction from NV, absolute encoders call this at the end of init()
+  void Encoder::correctionInit() {
+    char keyStr[20];
+    snprintf(keyStr, sizeof(keyStr), "AXIS%u_ENC_CORR", (unsigned)axis);
+
+    EncoderCorrection stored;
+    if (nv().kv().get(nv().kv().computeKey(keyStr), stored) != KvPartition::Status::Ok) return;
+
+    if (!setCorrection(stored, false)) {
+      VF("MSG: Encoder"); V(axis); VLF(", resolution changed, ignoring the correction on NV");
+    }
+  }
+#endif
+
 #endif
@@ -14,8 +14,9 @@
 #if ENCODER_VELOCITY == ON
 
   // ENCODER_VEL_WINDOW_US:
-  //   Window length for dc/dt estimate (microseconds). Smaller = more responsive/noisier
-  //   larger = smoother/more lag. Typical: 5000–20000 us for 100–1000 Hz control loops
+  //   Minimum window length for the count over time estimate (microseconds), the window
+  //   always runs from one count to a later one so it spans whole counts over exactly measured time
+  //   Smaller = more responsive/noisier, larger = smoother/more lag. Typical: 5000–20000 us
   #ifndef ENCODER_VEL_WINDOW_US
     #define ENCODER_VEL_WINDOW_US 10000UL  // default 10ms (10000UL)
   #endif
@@ -29,23 +30,52 @@
   #endif
 
   // ENCODER_VEL_BLEND_COUNTS:
-  //   Blend point between period (t/d) and windowed (d/t) estimates
-  //   Larger values favor period estimate longer (better at low counts/sec)
-  //   Typical: 4–12 counts
+  //   Counts per window above which the count over time estimate takes over from the tracking observer
+  //   (below one count per window the period estimate is used, in between the tracking observer)
+  //   Larger values favor the observer longer. Typical: 4–12 counts
   #ifndef ENCODER_VEL_BLEND_COUNTS
     #define ENCODER_VEL_BLEND_COUNTS 4.0F // 4 counts (4.0F)
   #endif
 
+  // ENCODER_VEL_PLL_HZ:
+  //   Bandwidth of the phase-locked tracking observer (Hz), critically damped at any read interval
+  //   Smaller = smoother/more lag. Typical: 5–50 Hz, above about a sixth of the read rate it just follows the count
+  #ifndef ENCODER_VEL_PLL_HZ
+    #define ENCODER_VEL_PLL_HZ 20.0F // 20 Hz (20.0F)
+  #endif
+
   // --------------------------------------------------------------------------
   // An example for very low count systems (copy/paste into your Config.h to override):
   //
   //   #define ENCODER_VEL_WINDOW_US      20000UL   // 20ms smoother
   //   #define ENCODER_VEL_STOP_US      1000000UL   // 1.0s avoid false “stops”
-  //   #define ENCODER_VEL_BLEND_COUNTS     8.0F    // rely on period estimate longer
+  //   #define ENCODER_VEL_BLEND_COUNTS     8.0F    // rely on the tracking observer longer
+  //   #define ENCODER_VEL_PLL_HZ          10.0F    // smoother tracking observer
   // --------------------------------------------------------------------------
 
 #endif
 
+// ENCODER_CORRECTION:
+//   ON corrects absolute encoders for their repeatable error over one turn (mounting eccentricity,
+//   interpolation harmonics) using harmonics measured by the servo encoder calibration and kept in NV
+#ifndef ENCODER_CORRECTION
+  #define ENCODER_CORRECTION OFF
+#endif
+
+#if ENCODER_CORRECTION == ON
+  #define ENCODER_CORRECTION_HARMONICS 8     // harmonics of one turn, fixed as it sets the NV record layout
+  #define ENCODER_CORRECTION_LUT_BITS 8      // the lookup table has 2^n entries over one turn
+
+  #pragma pack(1)
+  // correction harmonics as kept in NV, 68 bytes
+  typedef struct EncoderCorrection {
+    uint32_t countsPerTurn;                           // single turn counts measured over, 0 if none
+    float cosine[ENCODER_CORRECTION_HARMONICS];       // error of harmonic 1, 2, ... in single turn counts
+    float sine[ENCODER_CORRECTION_HARMONICS];
+  } EncoderCorrection;
+  #pragma pack()
+#endif
+
 // ENCODER_ERROR_COUNT_THRESHOLD:
 // allow up to 20 errors per minute before throwing a fault
 #ifndef ENCODER_ERROR_COUNT_THRESHOLD
@@ -139,6 +169,9 @@ class Encoder {
     // true when this encoder can report absolute position after boot
     virtual bool isAbsolute() const { return false; }
 
+    // true when read() is quick and bounded so it can be called from a timer ISR
+    virtual bool isrSafe() const { return true; }
+
     // set encoder origin
     virtual void setOrigin(int32_t counts) { origin = counts; }
 
@@ -190,70 +223,122 @@ class Encoder {
     inline long motorStepsAtLastRead() const { return motorStepsAtLastReadValue; }
     inline void setMotorStepsPtr(volatile long* p) { motorStepsPtr = p; }
 
+    #if ENCODER_CORRECTION == ON
+      // single turn counts of an encoder that supports correction, or 0
+      virtual uint32_t countsPerTurn() const { return 0; }
+
+      // the same turn in the counts read() returns (motor steps), or 0
+      virtual uint32_t stepsPerTurn() const { return countsPerTurn(); }
+
+      // set the correction harmonics and optionally save them to NV
+      // \returns false if they weren't measured over this encoder's turn
+      bool setCorrection(const EncoderCorrection &harmonics, bool save = true);
+
+      // forget the correction, also in NV
+      void clearCorrection();
+
+      // the correction harmonics in use, countsPerTurn is 0 if none
+      inline const EncoderCorrection& getCorrection() const { return correction; }
+
+      // pause the correction (while calibrating) without forgetting it
+      inline void correctionEnable(bool state) { correctionEnabled = state; }
+
+      // single turn count (before correction, origin, or index) as last read
+      volatile uint32_t turnCount = 0;
+    #endif
+
   protected:
+    #if ENCODER_CORRECTION == ON
+      // read the correction from NV, absolute encoders call this at the end of init()
+      void correctionInit();
+
+      // correction (in single turn counts) at the single turn count, by interpolating the lookup table
+      inline int32_t IRAM_ATTR correctionAt(uint32_t singleTurnCount) {
+        if (!correctionReady || !correctionEnabled) return 0;
+        const uint32_t position = (uint32_t)(((uint64_t)singleTurnCount*correctionScale) >> 32);
+        const uint32_t i = (position >> 8) & ((1UL << ENCODER_CORRECTION_LUT_BITS) - 1);
+        const int32_t fraction = position & 0xFF;
+        const int32_t value = correctionLut[i] + (((correctionLut[i + 1] - correctionLut[i])*fraction) >> 8);
+        return (value + 8) >> 4;
+      }
+    #endif
+
+
     #if ENCODER_VELOCITY == ON
-      inline void IRAM_ATTR velNoteEdge(int8_t dir) {
-        const uint32_t now = HAL_FAST_TICKS();
+      // note an encoder edge with the time it happened, in HAL_FAST_TICKS() units, encoders with hardware
+      // input capture should pass the captured time so interrupt latency doesn't add to the velocity noise
+      inline void IRAM_ATTR velNoteEdgeAt(int8_t dir, uint32_t ticks) {
         const uint32_t prev = velLastEdgeTicks;
-        velLastEdgeTicks = now;
+        velLastEdgeTicks = ticks;
         velLastDir = dir;
-        if (prev != 0) velLastPeriodTicks = now - prev;
+        velEdgeCount += dir;
+        if (prev != 0) velLastPeriodTicks = ticks - prev;
       }
 
-      inline void velNoteDelta(int32_t dc, uint32_t dtUs) {
-        if (dc == 0 || dtUs == 0) return;
+      // note an encoder edge as it happens (from the edge ISR)
+      inline void IRAM_ATTR velNoteEdge(int8_t dir) { velNoteEdgeAt(dir, HAL_FAST_TICKS()); }
+
+      // note a change of dc counts seen now (for devices without edge ISR info)
+      inline void velNoteDelta(int32_t dc) {
+        if (dc == 0) return;
 
         const uint32_t nowTicks = HAL_FAST_TICKS();
-        const uint32_t tps = velTicksPerSec;
         const uint32_t absdc = (dc > 0) ? (uint32_t)dc : (uint32_t)(-dc);
 
-        uint64_t dtTicks = (uint64_t)dtUs * (uint64_t)tps;
-        dtTicks = (dtTicks + 500000ULL) / 1000000ULL;
-
-        uint32_t perTicks = (uint32_t)((dtTicks + (absdc/2)) / absdc);
-        if (perTicks == 0) perTicks = 1;
-
         noInterrupts();
-        velLastEdgeTicks   = nowTicks;
-        velLastPeriodTicks = perTicks;
-        velLastDir         = (dc > 0) ? 1 : -1;
+        const uint32_t prev = velLastEdgeTicks;
+        velLastEdgeTicks = nowTicks;
+        velLastDir       = (dc > 0) ? 1 : -1;
+        velEdgeCount    += dc;
+        if (prev != 0) {
+          uint32_t perTicks = (nowTicks - prev + (absdc/2))/absdc;
+          velLastPeriodTicks = perTicks == 0 ? 1 : perTicks;
+        }
         interrupts();
       }
 
       // Feed velocity estimator from sampled count reads (for devices without edge ISR info)
       // Note: pass raw encoder count (pre-index) to avoid velocity spikes on write()/index changes
       inline void velNoteSampledCount(int32_t rawCount) {
-        const uint32_t nowUs = micros();
-
         if (!velSampleInit) {
           velSampleInit = true;
           velSampleLastCount = rawCount;
-          velSampleLastUs  = nowUs;
           return;
         }
 
-        const uint32_t dtUs = nowUs - velSampleLastUs;
-        const int32_t  dc   = rawCount - velSampleLastCount;
-
+        const int32_t dc = rawCount - velSampleLastCount;
         velSampleLastCount = rawCount;
-        velSampleLastUs  = nowUs;
 
-        if (dc != 0 && dtUs != 0) velNoteDelta(dc, dtUs);
+        if (dc != 0) velNoteDelta(dc);
       }
 
       bool     velHasEstimate     = false;
       bool     velSampleInit      = false;
       int32_t  velSampleLastCount = 0;
-      uint32_t velSampleLastUs    = 0;
       uint32_t velStopTicks       = 0;
+      uint32_t velWindowTicks     = 0;
 
+      // latest edge (or count change) from the ISR or sampled reads
       volatile uint32_t velLastEdgeTicks   = 0;
       volatile uint32_t velLastPeriodTicks = 0;
+      volatile int32_t  velEdgeCount       = 0;
       volatile int8_t   velLastDir         = 0;
       uint32_t          velTicksPerSec     = 1000000UL;
 
-      int32_t  velWinLastCount = 0;
-      uint32_t velWinLastUs    = 0;
+      // adaptive count over time window, it starts and ends on an edge
+      bool     velWinStarted    = false;
+      int32_t  velWinStartCount = 0;
+      uint32_t velWinStartTicks = 0;
+      float    velWindowCps     = NAN;
+
+      // phase-locked tracking observer, position is velPllBase + velPllPos counts
+      bool     velPllInit      = false;
+      int32_t  velPllBase      = 0;
+      float    velPllPos       = 0.0F;
+      float    velPllCps       = 0.0F;
+      uint32_t velPllLastTicks = 0;
+      float    velPllWn        = 0.0F;  // in radians per second
+
       float    velBlendCps     = 0.0F;
     #endif
 
@@ -287,6 +372,14 @@ class Encoder {
     volatile bool hasMotorStepsAtLastReadValue = false;
     volatile long motorStepsAtLastReadValue = 0;
     volatile long * volatile motorStepsPtr = nullptr;
+
+    #if ENCODER_CORRECTION == ON
+      EncoderCorrection correction = {};
+      int32_t correctionLut[(1 << ENCODER_CORRECTION_LUT_BITS) + 1]; // in 1/16 counts, the last entry repeats the first
+      uint64_t correctionScale = 0;             // turn count to table position (with 8 fraction bits), 32.32 fixed point
+      volatile bool correctionReady = false;
+      volatile bool correctionEnabled = true;
+    #endif
 };
 
 #endif
@@ -4,7 +4,11 @@
 
 #ifdef HAS_BISS_C
 
-#if BISSC_SAMPLE_IN_LOW_PHASE == ON
+#if BISSC_SPI == ON
+  Bissc *Bissc::spiEncoder[2] = {NULL, NULL};
+  uint8_t Bissc::spiEncoderCount = 0;
+  volatile bool Bissc::spiBatchBusy = false;
+#elif BISSC_SAMPLE_IN_LOW_PHASE == ON
   #define BISSC_SAMPLE_LOW_AND_READ(sampleAction) \
     delayNanoseconds(tSample);                    \
     sampleAction;                                \
@@ -26,10 +30,6 @@ bool Bissc::init() {
   if (!Encoder::init()) return false;
   if (encoderBits < 8 || encoderBits > 31) return false;
 
-  pinMode(maPin, OUTPUT);
-  digitalWriteF(maPin, LOW);
-  pinMode(sloPin, INPUT_PULLUP);
-
   // get the counts/mask ready
   encoderCounts = (uint32_t)(1UL << encoderBits);
   encoderHalfCounts = (int32_t)(encoderCounts >> 1);
@@ -37,6 +37,56 @@ bool Bissc::init() {
   const uint8_t lowTurnBits = (encoderBits >= 32) ? 0 : (uint8_t)(32U - encoderBits);
   encoderMultiTurnMask = (lowTurnBits >= 32) ? 0xFFFFFFFFUL : ((1UL << lowTurnBits) - 1UL);
 
+  #if BISSC_SPI == ON
+    if (axis == 1) spi = &AXIS1_ENCODER_SPI_PORT; else
+    #ifdef AXIS2_ENCODER_SPI_PORT
+      if (axis == 2) spi = &AXIS2_ENCODER_SPI_PORT; else
+    #endif
+    return false;
+
+    // MA (SCK) idles high, sampling on the rising edge is in the low phase and on the falling edge the high phase
+    #if BISSC_SAMPLE_IN_LOW_PHASE == ON
+      spiSettings = SPISettings(BISSC_CLOCK_RATE_KHZ*1000UL, MSBFIRST, SPI_MODE3);
+    #else
+      spiSettings = SPISettings(BISSC_CLOCK_RATE_KHZ*1000UL, MSBFIRST, SPI_MODE2);
+    #endif
+
+    #if defined(ESP32)
+      spi->begin(maPin, sloPin, -1, -1);
+    #elif defined(TEENSYDUINO)
+      spi->setSCK(maPin);
+      spi->setMISO(sloPin);
+      spi->begin();
+    #else
+      spi->begin();
+    #endif
+
+    // room for the longest Ack and Start search plus the data, Err, Wrn, and CRC bits
+    const int frameBits = BISSC_SYNC_PHASE + BISSC_ACK_PHASE + 1 + encoderMultiTurnBits + encoderBits + 8;
+    spiFrameBytes = (frameBits + 7)/8;
+    if (spiFrameBytes > sizeof(spiFrame)) { DF("ERR: Encoder "); D(encoderName); DLF(", frame too long for SPI"); return false; }
+
+    #ifdef BISSC_SPI_DMA
+      spiEvent.setContext(this);
+      spiEvent.attachImmediate(&Bissc::frameEvent);
+    #endif
+
+    if (spiEncoderCount < 2) spiEncoder[spiEncoderCount++] = this;
+
+    VF("MSG: Encoder "); V(encoderName); VF(", reading frames by SPI");
+    #ifdef BISSC_SPI_DMA
+      VF(" with DMA");
+    #endif
+    #if BISSC_SPI_BATCH == ON
+      VF(" batched with other axes");
+    #endif
+    VLF("");
+  #else
+    pinMode(maPin, OUTPUT);
+    digitalWriteF(maPin, LOW);
+    pinMode(sloPin, INPUT_PULLUP);
+  #endif
+
   VF("MSG: Encoder "); V(encoderName); VLF(", confirming attempt 1...");
 
   // see if the encoder is there
@@ -51,6 +101,10 @@ bool Bissc::init() {
 
   VF("MSG: Encoder "); V(encoderName); VLF(", confirmation success");
 
+  #if ENCODER_CORRECTION == ON
+    correctionInit();
+  #endif
+
   ready = true;
   return true;
 }
@@ -115,54 +169,86 @@ void Bissc::write(int32_t position) {
 // returns encoder count or INT32_MAX on error
 int32_t Bissc::getCountWithErrorRecovery(bool immediate) {
   const unsigned long now = millis();
-  if (immediate || now - lastValidTime > 2) {
-    uint32_t newCount = 0;
-    if (getCount(newCount)) {
-      lastValidTime = now;
-      lastValidCount = newCount;
-
-      #if ENCODER_VELOCITY == ON
-        velNoteSampledCount((int32_t)newCount);
-      #endif
 
-    } else {
-      if (now - lastValidTime > 1000U) lastValidCount = INT32_MAX;
+  #if BISSC_SPI == ON
+    if (immediate) {
+      uint32_t newCount = 0;
+      if (getCount(newCount)) {
+        lastValidTime = now;
+        lastValidCount = newCount;
+      }
+    } else serviceFrames();
+
+    if (now - lastValidTime > 1000U) lastValidCount = INT32_MAX;
+  #else
+    if (immediate || now - lastValidTime > 2) {
+      uint32_t newCount = 0;
+      if (getCount(newCount)) {
+        lastValidTime = now;
+        lastValidCount = newCount;
+
+        #if ENCODER_VELOCITY == ON
+          velNoteSampledCount((int32_t)newCount);
+        #endif
+
+      } else {
+        if (now - lastValidTime > 1000U) lastValidCount = INT32_MAX;
+      }
     }
-  }
+  #endif
 
   return lastValidCount;
 }
 
 // get encoder count relative to origin
 bool Bissc::getCount(uint32_t &count) {
-
-  // prepare for a reading
-  foundAck = false;
-  foundStart = false;
-  foundCds = false;
-
-  nErr = 1;
-  nWrn = 1;
-  frameCrc = 0;
-
-  turns = 0;
-  count = 0;
-
-  #ifdef ESP32
-    static portMUX_TYPE bisscMutex = portMUX_INITIALIZER_UNLOCKED;
-    taskENTER_CRITICAL(&bisscMutex);
-  #else
-    noInterrupts();
-  #endif
-
-  getCountBitBang(count);
-
-  #ifdef ESP32
-    taskEXIT_CRITICAL(&bisscMutex);
+  #if BISSC_SPI == ON
+    // wait for and claim the frame and parse state, a control loop read that interrupts this returns the last count
+    while (!spiClaim()) {}
+
+    // finish any frame in progress, then read one now
+    while (!frameDone()) {}
+    startFrame();
+    while (!frameDone()) {}
+    spiStarted = false;
+
+    const bool result = parseFrame(count);
+    spiClaimed = false;
+    return result;
   #else
-    interrupts();
+    // prepare for a reading
+    foundAck = false;
+    foundStart = false;
+    foundCds = false;
+
+    nErr = 1;
+    nWrn = 1;
+    frameCrc = 0;
+
+    turns = 0;
+    count = 0;
+
+    #ifdef ESP32
+      static portMUX_TYPE bisscMutex = portMUX_INITIALIZER_UNLOCKED;
+      taskENTER_CRITICAL(&bisscMutex);
+    #else
+      noInterrupts();
+    #endif
+
+    getCountBitBang(count);
+
+    #ifdef ESP32
+      taskEXIT_CRITICAL(&bisscMutex);
+    #else
+      interrupts();
+    #endif
+
+    return decodeFrame(count);
   #endif
+}
 
+// check the frame just read and convert it to an encoder count
+bool Bissc::decodeFrame(uint32_t &count) {
   // trap errors
   int16_t errors = 0;
 
@@ -202,11 +288,23 @@ bool Bissc::getCount(uint32_t &count) {
     return false;
   }
 
+  #if ENCODER_CORRECTION == ON
+    turnCount = count;
+  #endif
+
   #if BISSC_SINGLE_TURN != ON
     // combine absolute and low order bits of multi-turn count for a 32 bit count
     count = count | ((turns & encoderMultiTurnMask) << encoderBits);
   #endif
 
+  #if ENCODER_CORRECTION == ON
+    // remove the repeatable error at this point in the turn
+    count -= (uint32_t)correctionAt(turnCount);
+    #if BISSC_SINGLE_TURN == ON
+      count &= encoderCounts - 1;
+    #endif
+  #endif
+
   // apply origin
   count += origin;
 
@@ -221,6 +319,143 @@ bool Bissc::getCount(uint32_t &count) {
   return true;
 }
 
+#if BISSC_SPI == ON
+
+#ifdef BISSC_SPI_DMA
+  void Bissc::frameEvent(EventResponderRef event) {
+    Bissc *encoder = (Bissc*)event.getContext();
+    encoder->spi->endTransaction();
+    encoder->spiBusy = false;
+  }
+#endif
+
+// start reading a frame into spiFrame
+IRAM_ATTR void Bissc::startFrame() {
+  if (motorStepsPtr) spiMotorSteps = *motorStepsPtr;
+
+  // MOSI isn't used, the clocks past the end of the frame are ignored by parseFrame()
+  memset(spiFrame, 0xFF, spiFrameBytes);
+  spiBusy = true;
+  spiStarted = true;
+
+  spi->beginTransaction(spiSettings);
+  #ifdef BISSC_SPI_DMA
+    spi->transfer(spiFrame, spiFrame, spiFrameBytes, spiEvent);
+  #else
+    spi->transfer(spiFrame, spiFrameBytes);
+    spi->endTransaction();
+    spiBusy = false;
+  #endif
+}
+
+// decode the frame in spiFrame and note the count
+IRAM_ATTR void Bissc::collectFrame() {
+  spiStarted = false;
+
+  uint32_t newCount = 0;
+  if (parseFrame(newCount)) {
+    lastValidTime = millis();
+    lastValidCount = newCount;
+
+    motorStepsAtLastReadValue = spiMotorSteps;
+    hasMotorStepsAtLastReadValue = motorStepsPtr != nullptr;
+
+    #if ENCODER_VELOCITY == ON
+      velNoteSampledCount((int32_t)newCount);
+    #endif
+  }
+}
+
+// pick up finished frames and start the next ones, so with DMA a read returns the
+// count from the frame started by the read before it
+IRAM_ATTR void Bissc::serviceFrames() {
+  #if BISSC_SPI_BATCH == ON
+    // whichever encoder reads first reads for all of them so the frames are from the same window and
+    // each axis gets fresh counts however often the others read, a read that interrupts one in progress
+    // returns the last count
+    if (spiBatchBusy) return;
+    spiBatchBusy = true;
+
+    // an encoder being read on its own (getCount()) is left out
+    bool claimed[2] = {false, false};
+    for (int i = 0; i < spiEncoderCount; i++) claimed[i] = spiEncoder[i]->spiClaim();
+
+    for (int i = 0; i < spiEncoderCount; i++) {
+      Bissc *encoder = spiEncoder[i];
+      if (claimed[i] && encoder->spiStarted && encoder->frameDone()) encoder->collectFrame();
+    }
+    for (int i = 0; i < spiEncoderCount; i++) {
+      Bissc *encoder = spiEncoder[i];
+      if (claimed[i] && !encoder->spiStarted) encoder->startFrame();
+    }
+    for (int i = 0; i < spiEncoderCount; i++) {
+      Bissc *encoder = spiEncoder[i];
+      if (claimed[i] && encoder->spiStarted && encoder->frameDone()) encoder->collectFrame();
+    }
+
+    for (int i = 0; i < spiEncoderCount; i++) if (claimed[i]) spiEncoder[i]->spiClaimed = false;
+    spiBatchBusy = false;
+  #else
+    // a read that interrupts another of this encoder returns the last count
+    if (!spiClaim()) return;
+
+    if (spiStarted && frameDone()) collectFrame();
+    if (!spiStarted) {
+      startFrame();
+      if (frameDone()) collectFrame();
+    }
+
+    spiClaimed = false;
+  #endif
+}
+
+// find the Ack, Start, Cds, and data bits in spiFrame as getCountBitBang() does on the wire
+IRAM_ATTR bool Bissc::parseFrame(uint32_t &count) {
+  foundAck = false;
+  foundStart = false;
+  foundCds = false;
+
+  nErr = 1;
+  nWrn = 1;
+  frameCrc = 0;
+
+  turns = 0;
+  count = 0;
+
+  const int frameBits = spiFrameBytes*8;
+  int n = 0;
+
+  // sync phase
+  for (; n < BISSC_SYNC_PHASE && n < frameBits; n++) { if (!frameBit(n)) { foundAck = true; n++; break; } }
+
+  // if we have an Ack
+  if (foundAck) {
+    for (int i = 0; i < BISSC_ACK_PHASE && n < frameBits; i++, n++) { if (frameBit(n)) { foundStart = true; n++; break; } }
+
+    // if we have a Start and a Cds, read the data when the frame holds all of it
+    if (foundStart && n < frameBits && !frameBit(n++) && n + encoderMultiTurnBits + encoderBits + 8 <= frameBits) {
+      foundCds = true;
+
+      // the first n bits are the multi-turn count
+      for (int i = 1; i <= encoderMultiTurnBits; i++) { if (frameBit(n++)) bitSet(turns, encoderMultiTurnBits - i); }
+
+      // the next n bits are the encoder absolute count
+      for (int i = 1; i <= encoderBits; i++) { if (frameBit(n++)) bitSet(count, encoderBits - i); }
+
+      // the Err and Wrn bits
+      nErr = frameBit(n++);
+      nWrn = frameBit(n++);
+
+      // the last 6 bits are the CRC
+      for (int i = 0; i < 6; i++) { if (frameBit(n++)) bitSet(frameCrc, 5 - i); }
+    }
+  }
+
+  return decodeFrame(count);
+}
+
+#else
+
 IRAM_ATTR void Bissc::getCountBitBang(uint32_t &count) {
 
   // sync phase
@@ -282,3 +517,5 @@ IRAM_ATTR void Bissc::getCountBitBang(uint32_t &count) {
 }
 
 #endif
+
+#endif
@@ -52,6 +52,38 @@
     #error "Configuration (Config.h): BISSC_TSAMPLE_QUARTERS must be between 1 and 3"
   #endif
 
+  // read the frame with an SPI peripheral instead of bit-banging, MA is wired to SCK and SLO to MISO
+  // of a bus that isn't shared with other devices (the encoder always drives SLO), on Teensy 3.5/3.6/4.x
+  // the transfer is by DMA and runs while the control loop continues, the result is picked up at the next read
+  #ifndef BISSC_SPI
+    #define BISSC_SPI OFF
+  #endif
+
+  // the SPI port for each axis, only Teensy 3.5/3.6/4.x have a second port by default
+  #ifndef AXIS1_ENCODER_SPI_PORT
+    #define AXIS1_ENCODER_SPI_PORT SPI
+  #endif
+  #ifndef AXIS2_ENCODER_SPI_PORT
+    #if defined(__IMXRT1062__) || defined(__MK66FX1M0__) || defined(__MK64FX512__)
+      #define AXIS2_ENCODER_SPI_PORT SPI1
+    #elif BISSC_SPI == ON && (AXIS2_ENCODER == AS37_H39B_B || AXIS2_ENCODER == LIKA_ASC85 || AXIS2_ENCODER == JTW_24BIT || AXIS2_ENCODER == JTW_26BIT)
+      #error "Configuration (Config.h): BISSC_SPI ON needs AXIS2_ENCODER_SPI_PORT set on this platform"
+    #endif
+  #endif
+
+  // with BISSC_SPI, whichever encoder reads first starts the frames of both axes so they are read in one window
+  #ifndef BISSC_SPI_BATCH
+    #define BISSC_SPI_BATCH OFF
+  #endif
+
+  #if BISSC_SPI == ON && (defined(__IMXRT1062__) || defined(__MK66FX1M0__) || defined(__MK64FX512__))
+    #define BISSC_SPI_DMA
+  #endif
+
+  #if BISSC_SPI == ON
+    #include <SPI.h>
+  #endif
+
   // resolution adjustment use 2, 4, or 8 (example:)
   //#define BISSC_RESOLUTION_DIVISOR 4
 
@@ -76,6 +108,28 @@
 
       bool isAbsolute() const override { return true; }
 
+      #ifdef BISSC_SPI_DMA
+        // the frame is read by DMA and picked up at the next read
+        bool isrSafe() const override { return true; }
+      #else
+        // the bit-banged frame and error recovery re-reads are too slow for a timer ISR
+        bool isrSafe() const override { return false; }
+      #endif
+
+      #if BISSC_SPI == ON
+        // the motor steps are noted when the frame is started
+        bool supportsTimeAlignedMotorSteps() const { return true; }
+      #endif
+
+      #if ENCODER_CORRECTION == ON
+        // the correction is over the single turn count
+        uint32_t countsPerTurn() const override { return encoderCounts; }
+
+        #ifdef BISSC_RESOLUTION_DIVISOR
+          uint32_t stepsPerTurn() const override { return encoderCounts/(BISSC_RESOLUTION_DIVISOR); }
+        #endif
+      #endif
+
       // set encoder origin
       void setOrigin(int32_t counts);
 
@@ -93,8 +147,53 @@
       // read encoder count
       bool getCount(uint32_t &count);
 
-      // low level bitbang read encoder count
-      IRAM_ATTR void getCountBitBang(uint32_t &count);
+      // check the frame just read and convert it to an encoder count
+      bool decodeFrame(uint32_t &count);
+
+      #if BISSC_SPI == ON
+        // start reading a frame into spiFrame
+        void startFrame();
+
+        // true once the frame started is in spiFrame
+        inline bool frameDone() { return !spiBusy; }
+
+        // decode the frame in spiFrame and note the count
+        void collectFrame();
+
+        // pick up finished frames and start the next ones
+        void serviceFrames();
+
+        // claim the frame and the parse state for one read
+        // \returns false if another read has them
+        inline bool spiClaim() { noInterrupts(); bool result = !spiClaimed; spiClaimed = true; interrupts(); return result; }
+
+        // find the Ack, Start, Cds, and data bits in spiFrame
+        bool parseFrame(uint32_t &count);
+
+        // bit n of the frame as sampled from SLO, true if HIGH_SLO
+        inline bool frameBit(int n) { return (((spiFrame[n >> 3] >> (7 - (n & 7))) & 1) != 0) == (HIGH_SLO == HIGH); }
+
+        #ifdef BISSC_SPI_DMA
+          static void frameEvent(EventResponderRef event);
+          EventResponder spiEvent;
+        #endif
+
+        SPIClass *spi = NULL;
+        SPISettings spiSettings;
+        uint8_t spiFrame[16];
+        uint8_t spiFrameBytes = 0;
+        volatile bool spiBusy = false;         // a frame is being read
+        bool spiStarted = false;               // a frame was started and not yet collected
+        volatile bool spiClaimed = false;      // a read is using the frame and the parse state
+        long spiMotorSteps = 0;                // motor steps when the frame was started
+
+        static Bissc *spiEncoder[2];
+        static uint8_t spiEncoderCount;
+        static volatile bool spiBatchBusy;     // an encoder is reading for all of them
+      #else
+        // low level bitbang read encoder count
+        IRAM_ATTR void getCountBitBang(uint32_t &count);
+      #endif
 
       // the custom crc routine
       virtual uint8_t crc6(uint64_t data) = 0;
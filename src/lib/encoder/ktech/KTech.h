@@ -23,6 +23,7 @@ class KTechIME : public Encoder {
     void write(int32_t position);
 
     bool supportsTimeAlignedMotorSteps() const { return true; }
+    bool isrSafe() const override { return false; }
     void updatePositionCallback(uint8_t data[8]);
     void updateVelocityCallback(uint8_t data[8]);
 
@@ -19,6 +19,7 @@ class SerialBridge : public Encoder {
   public:
     SerialBridge(int16_t axis);
     bool isAbsolute() const override { return SERIAL_ENCODER_ABSOLUTE == ON; }
+    bool isrSafe() const override { return false; }
     int32_t read();
     void write(int32_t count);
     bool errorThresholdExceeded() { return errorDetected; }
@@ -132,6 +132,10 @@ int32_t VirtualEnc::read() {
   count = _virtual_count[axis_index];
   interrupts();
 
+  #if ENCODER_VELOCITY == ON
+    velNoteSampledCount(count);
+  #endif
+
   return count + index;
 }
 
@@ -45,6 +45,8 @@
 
   #if AXIS@_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis@(AXIS@_SERVO_FLTR_MEAS_U, AXIS@_SERVO_FLTR_VARIANCE);
+  #elif AXIS@_SERVO_FLTR == LEARNING
+    LearningFilter filterAxis@(@, AXIS@_SERVO_FLTR_WSIZE, AXIS@_SERVO_FLTR_PERIOD1, AXIS@_SERVO_FLTR_PERIOD2, AXIS@_SERVO_FLTR_PERIOD3);
   #elif AXIS@_SERVO_FLTR == ROLLING
     RollingFilter filterAxis@(AXIS@_SERVO_FLTR_WSIZE);
   #elif AXIS@_SERVO_FLTR == OFF
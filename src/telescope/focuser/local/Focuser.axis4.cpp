@@ -45,6 +45,8 @@
 
   #if AXIS4_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis4(AXIS4_SERVO_FLTR_MEAS_U, AXIS4_SERVO_FLTR_VARIANCE);
+  #elif AXIS4_SERVO_FLTR == LEARNING
+    LearningFilter filterAxis4(4, AXIS4_SERVO_FLTR_WSIZE, AXIS4_SERVO_FLTR_PERIOD1, AXIS4_SERVO_FLTR_PERIOD2, AXIS4_SERVO_FLTR_PERIOD3);
   #elif AXIS4_SERVO_FLTR == ROLLING
     RollingFilter filterAxis4(AXIS4_SERVO_FLTR_WSIZE);
   #elif AXIS4_SERVO_FLTR == OFF
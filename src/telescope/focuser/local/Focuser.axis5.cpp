@@ -45,6 +45,8 @@
 
   #if AXIS5_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis5(AXIS5_SERVO_FLTR_MEAS_U, AXIS5_SERVO_FLTR_VARIANCE);
+  #elif AXIS5_SERVO_FLTR == LEARNING
+    LearningFilter filterAxis5(5, AXIS5_SERVO_FLTR_WSIZE, AXIS5_SERVO_FLTR_PERIOD1, AXIS5_SERVO_FLTR_PERIOD2, AXIS5_SERVO_FLTR_PERIOD3);
   #elif AXIS5_SERVO_FLTR == ROLLING
     RollingFilter filterAxis5(AXIS5_SERVO_FLTR_WSIZE);
   #elif AXIS5_SERVO_FLTR == OFF
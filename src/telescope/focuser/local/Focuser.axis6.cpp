@@ -45,6 +45,8 @@
 
   #if AXIS6_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis6(AXIS6_SERVO_FLTR_MEAS_U, AXIS6_SERVO_FLTR_VARIANCE);
+  #elif AXIS6_SERVO_FLTR == LEARNING
+    LearningFilter filterAxis6(6, AXIS6_SERVO_FLTR_WSIZE, AXIS6_SERVO_FLTR_PERIOD1, AXIS6_SERVO_FLTR_PERIOD2, AXIS6_SERVO_FLTR_PERIOD3);
   #elif AXIS6_SERVO_FLTR == ROLLING
     RollingFilter filterAxis6(AXIS6_SERVO_FLTR_WSIZE);
   #elif AXIS6_SERVO_FLTR == OFF
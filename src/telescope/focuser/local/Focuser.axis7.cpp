@@ -45,6 +45,8 @@
 
   #if AXIS7_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis7(AXIS7_SERVO_FLTR_MEAS_U, AXIS7_SERVO_FLTR_VARIANCE);
+  #elif AXIS7_SERVO_FLTR == LEARNING
+    LearningFilter filterAxis7(7, AXIS7_SERVO_FLTR_WSIZE, AXIS7_SERVO_FLTR_PERIOD1, AXIS7_SERVO_FLTR_PERIOD2, AXIS7_SERVO_FLTR_PERIOD3);
   #elif AXIS7_SERVO_FLTR == ROLLING
     RollingFilter filterAxis7(AXIS7_SERVO_FLTR_WSIZE);
   #elif AXIS7_SERVO_FLTR == OFF
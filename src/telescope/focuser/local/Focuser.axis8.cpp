@@ -45,6 +45,8 @@
 
   #if AXIS8_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis8(AXIS8_SERVO_FLTR_MEAS_U, AXIS8_SERVO_FLTR_VARIANCE);
+  #elif AXIS8_SERVO_FLTR == LEARNING
+    LearningFilter filterAxis8(8, AXIS8_SERVO_FLTR_WSIZE, AXIS8_SERVO_FLTR_PERIOD1, AXIS8_SERVO_FLTR_PERIOD2, AXIS8_SERVO_FLTR_PERIOD3);
   #elif AXIS8_SERVO_FLTR == ROLLING
     RollingFilter filterAxis8(AXIS8_SERVO_FLTR_WSIZE);
   #elif AXIS8_SERVO_FLTR == OFF
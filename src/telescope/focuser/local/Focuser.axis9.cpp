@@ -45,6 +45,8 @@
 
   #if AXIS9_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis9(AXIS9_SERVO_FLTR_MEAS_U, AXIS9_SERVO_FLTR_VARIANCE);
+  #elif AXIS9_SERVO_FLTR == LEARNING
+    LearningFilter filterAxis9(9, AXIS9_SERVO_FLTR_WSIZE, AXIS9_SERVO_FLTR_PERIOD1, AXIS9_SERVO_FLTR_PERIOD2, AXIS9_SERVO_FLTR_PERIOD3);
   #elif AXIS9_SERVO_FLTR == ROLLING
     RollingFilter filterAxis9(AXIS9_SERVO_FLTR_WSIZE);
   #elif AXIS9_SERVO_FLTR == OFF
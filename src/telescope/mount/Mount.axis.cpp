@@ -24,6 +24,10 @@ namespace {
 #elif defined(AXIS1_SERVO_PRESENT)
   ServoControl servoControlAxis1;
 
+  #if AXIS1_DRIVER_MODEL == SERVO_SIM
+    ServoSimPlant plantAxis1;
+  #endif
+
   #if AXIS1_ENCODER == AB
     Quadrature encAxis1(1, AXIS1_ENCODER_A_PIN, AXIS1_ENCODER_B_PIN);
   #elif AXIS1_ENCODER == AB_ESP32
@@ -48,18 +52,22 @@ namespace {
     KTechIME encAxis1(1);
   #elif AXIS1_ENCODER == SERIAL_BRIDGE
     SerialBridge encAxis1(1);
+  #elif AXIS1_ENCODER == SIMULATED
+    ServoSimEncoder encAxis1(1, &plantAxis1);
   #endif
 
   #if AXIS1_SERVO_FEEDBACK == PID
     Pid feedbackAxis1(AXIS1_PID_P, AXIS1_PID_I, AXIS1_PID_D);
   #elif AXIS1_SERVO_FEEDBACK == DUAL_PID
     DualPid feedbackAxis1(AXIS1_PID_P, AXIS1_PID_I, AXIS1_PID_D, AXIS1_PID_P_GOTO, AXIS1_PID_I_GOTO, AXIS1_PID_D_GOTO, AXIS1_PID_SENSITIVITY);
+  #elif AXIS1_SERVO_FEEDBACK == CASCADE
+    Cascade feedbackAxis1(AXIS1_CASCADE_POS_P, AXIS1_CASCADE_VEL_P, AXIS1_CASCADE_VEL_I, AXIS1_CASCADE_VEL_FF, AXIS1_CASCADE_ACCEL_FF);
   #endif
 
   #if AXIS1_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis1(AXIS1_SERVO_FLTR_MEAS_U, AXIS1_SERVO_FLTR_VARIANCE);
   #elif AXIS1_SERVO_FLTR == LEARNING
-    // nothing to do as this is auotmatically created... LearningFilter filterAxis1(AXIS1_SERVO_FLTR_WSIZE, 240);
+    LearningFilter filterAxis1(1, AXIS1_SERVO_FLTR_WSIZE, AXIS1_SERVO_FLTR_PERIOD1, AXIS1_SERVO_FLTR_PERIOD2, AXIS1_SERVO_FLTR_PERIOD3);
   #elif AXIS1_SERVO_FLTR == ROLLING
     RollingFilter filterAxis1(AXIS1_SERVO_FLTR_WSIZE);
   #elif AXIS1_SERVO_FLTR == OFF
@@ -83,6 +91,8 @@ namespace {
     ServoTmc5160 driver1(1, &DriverPinsAxis1, &DriverSettingsAxis1, AXIS1_STEPS_PER_DEGREE/AXIS1_COUNTS_PER_DEGREE, AXIS1_DRIVER_MICROSTEPS, AXIS1_DRIVER_IRUN, AXIS1_DRIVER_DECAY, AXIS1_DRIVER_DECAY_GOTO);
   #elif AXIS1_DRIVER_MODEL == SERVO_KTECH
     ServoKTech driver1(1, &DriverSettingsAxis1, AXIS1_STEPS_PER_DEGREE/AXIS1_COUNTS_PER_DEGREE);
+  #elif AXIS1_DRIVER_MODEL == SERVO_SIM
+    ServoSim driver1(1, &DriverSettingsAxis1, &plantAxis1);
   #endif
 
   ServoMotor motor_1(1, AXIS1_REVERSE, ((ServoDriver*)&driver1), &filterAxis1, &encAxis1, AXIS1_ENCODER_ORIGIN, AXIS1_ENCODER_REVERSE == ON, &feedbackAxis1, &servoControlAxis1);
@@ -142,6 +152,10 @@ namespace {
 #elif defined(AXIS2_SERVO_PRESENT)
   ServoControl servoControlAxis2;
 
+  #if AXIS2_DRIVER_MODEL == SERVO_SIM
+    ServoSimPlant plantAxis2;
+  #endif
+
   #if AXIS2_ENCODER == AB
     Quadrature encAxis2(2, AXIS2_ENCODER_A_PIN, AXIS2_ENCODER_B_PIN);
   #elif AXIS2_ENCODER == AB_ESP32
@@ -166,16 +180,22 @@ namespace {
     KTechIME encAxis2(2);
   #elif AXIS2_ENCODER == SERIAL_BRIDGE
     SerialBridge encAxis2(2);
+  #elif AXIS2_ENCODER == SIMULATED
+    ServoSimEncoder encAxis2(2, &plantAxis2);
   #endif
 
   #if AXIS2_SERVO_FEEDBACK == PID
     Pid feedbackAxis2(AXIS2_PID_P, AXIS2_PID_I, AXIS2_PID_D);
   #elif AXIS2_SERVO_FEEDBACK == DUAL_PID
     DualPid feedbackAxis2(AXIS2_PID_P, AXIS2_PID_I, AXIS2_PID_D, AXIS2_PID_P_GOTO, AXIS2_PID_I_GOTO, AXIS2_PID_D_GOTO, AXIS2_PID_SENSITIVITY);
+  #elif AXIS2_SERVO_FEEDBACK == CASCADE
+    Cascade feedbackAxis2(AXIS2_CASCADE_POS_P, AXIS2_CASCADE_VEL_P, AXIS2_CASCADE_VEL_I, AXIS2_CASCADE_VEL_FF, AXIS2_CASCADE_ACCEL_FF);
   #endif
 
   #if AXIS2_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis2(AXIS2_SERVO_FLTR_MEAS_U, AXIS2_SERVO_FLTR_VARIANCE);
+  #elif AXIS2_SERVO_FLTR == LEARNING
+    LearningFilter filterAxis2(2, AXIS2_SERVO_FLTR_WSIZE, AXIS2_SERVO_FLTR_PERIOD1, AXIS2_SERVO_FLTR_PERIOD2, AXIS2_SERVO_FLTR_PERIOD3);
   #elif AXIS2_SERVO_FLTR == ROLLING
     RollingFilter filterAxis2(AXIS2_SERVO_FLTR_WSIZE);
   #elif AXIS2_SERVO_FLTR == OFF
@@ -199,6 +219,8 @@ namespace {
     ServoTmc5160 driver2(2, &DriverPinsAxis2, &DriverSettingsAxis2, AXIS2_STEPS_PER_DEGREE/AXIS2_COUNTS_PER_DEGREE, AXIS2_DRIVER_MICROSTEPS, AXIS2_DRIVER_IRUN, AXIS2_DRIVER_DECAY, AXIS2_DRIVER_DECAY_GOTO);
   #elif AXIS2_DRIVER_MODEL == SERVO_KTECH
     ServoKTech driver2(2, &DriverSettingsAxis2, AXIS2_STEPS_PER_DEGREE/AXIS2_COUNTS_PER_DEGREE);
+  #elif AXIS2_DRIVER_MODEL == SERVO_SIM
+    ServoSim driver2(2, &DriverSettingsAxis2, &plantAxis2);
   #endif
 
   ServoMotor motor_2(2, AXIS2_REVERSE, ((ServoDriver*)&driver2), &filterAxis2, &encAxis2, AXIS2_ENCODER_ORIGIN, AXIS2_ENCODER_REVERSE == ON, &feedbackAxis2, &servoControlAxis2);
@@ -433,6 +433,10 @@ bool Mount::command(char *reply, char *command, char *parameter, bool *suppressF
       #if GOTO_FEATURE == ON
         if (park.state != PS_PARKED) {
       #endif
+      #if LIMIT_KEEP_OUT == ON
+        // from inside a keep-out zone tracking must lead out
+        if (limits.isKeepOutError() && !limits.isKeepOutTrackingExit()) *commandError = CE_SLEW_ERR_OUTSIDE_LIMITS; else
+      #endif
       tracking(true);
       #if GOTO_FEATURE == ON
         } else *commandError = CE_PARKED;
@@ -461,21 +465,36 @@ bool Mount::command(char *reply, char *command, char *parameter, bool *suppressF
   // :$BR[n]#   Set RA/Azm backlash in arc-seconds
   //            Return: 0 on failure
   //                    1 on success
+  // :$Bd[n]#   Set Dec/Alt backlash taken up on reversals toward reverse in arc-seconds, -1 for the same as :$BD
+  //            Return: 0 on failure
+  //                    1 on success
+  // :$Br[n]#   Set RA/Azm backlash taken up on reversals toward reverse in arc-seconds, -1 for the same as :$BR
+  //            Return: 0 on failure
+  //                    1 on success
   //        Set the Backlash values.  Units are arc-seconds
   if (command[0] == '$' && command[1] == 'B') {
     int16_t arcSecs;
     if (convert.atoi2((char*)&parameter[1], &arcSecs)) {
-      if (arcSecs >= 0 && arcSecs <= 3600) {
+      bool reverse = parameter[0] == 'd' || parameter[0] == 'r';
+      if ((arcSecs >= 0 || (reverse && arcSecs == -1)) && arcSecs <= 3600) {
         if (parameter[0] == 'D') {
           settings.backlash.axis2 = arcsecToRad(arcSecs);
-          axis2.setBacklash(settings.backlash.axis2);
           nv().kv().put(nvKey, settings);
         } else
         if (parameter[0] == 'R') {
           settings.backlash.axis1 = arcsecToRad(arcSecs);
-          axis1.setBacklash(settings.backlash.axis1);
           nv().kv().put(nvKey, settings);
+        } else
+        if (parameter[0] == 'd' || parameter[0] == 'r') {
+          // only step/dir motors take up a different amount toward reverse
+          Axis *axis = parameter[0] == 'd' ? &axis2 : &axis1;
+          if (arcSecs >= 0 && axis->motor->driverType != STEP_DIR) *commandError = CE_CMD_UNKNOWN; else {
+            float value = arcSecs < 0 ? -1.0F : arcsecToRad(arcSecs);
+            if (parameter[0] == 'd') backlashReverse.axis2 = value; else backlashReverse.axis1 = value;
+            nv().kv().put(nvKeyBacklashReverse, backlashReverse);
+          }
         } else *commandError = CE_CMD_UNKNOWN;
+        if (*commandError == CE_NONE) applyBacklash();
       } else *commandError = CE_PARAM_RANGE;
     } else *commandError = CE_PARAM_FORM;
   } else
@@ -485,21 +504,24 @@ bool Mount::command(char *reply, char *command, char *parameter, bool *suppressF
   //            Return: n#
   // :%BR#      Get RA/Azm Antibacklash value in arc-seconds
   //            Return: n#
+  // :%Bd#      Get Dec/Alt Antibacklash value for reversals toward reverse in arc-seconds, -1 if the same as :%BD#
+  //            Return: n#
+  // :%Br#      Get RA/Azm Antibacklash value for reversals toward reverse in arc-seconds, -1 if the same as :%BR#
+  //            Return: n#
   if (command[0] == '%' && command[1] == 'B' && parameter[1] == 0) {
-    if (parameter[0] == 'D') {
-        int arcSec = round(radToArcsec(settings.backlash.axis2));
-        if (arcSec < 0) arcSec = 0;
-        if (arcSec > 3600) arcSec = 3600;
-        sprintf(reply, "%d", arcSec);
-        *numericReply = false;
-    } else
-    if (parameter[0] == 'R') {
-        int arcSec = round(radToArcsec(settings.backlash.axis1));
-        if (arcSec < 0) arcSec = 0;
-        if (arcSec > 3600) arcSec = 3600;
-        sprintf(reply, "%d", arcSec);
-        *numericReply = false;
-    } else *commandError = CE_CMD_UNKNOWN;
+    float backlash = 0.0F;
+    if (parameter[0] == 'D') backlash = settings.backlash.axis2; else
+    if (parameter[0] == 'R') backlash = settings.backlash.axis1; else
+    if (parameter[0] == 'd') backlash = backlashReverse.axis2; else
+    if (parameter[0] == 'r') backlash = backlashReverse.axis1; else *commandError = CE_CMD_UNKNOWN;
+
+    if (*commandError == CE_NONE) {
+      int arcSec = backlash < 0.0F ? -1 : round(radToArcsec(backlash));
+      if (arcSec < 0 && (parameter[0] == 'D' || parameter[0] == 'R')) arcSec = 0;
+      if (arcSec > 3600) arcSec = 3600;
+      sprintf(reply, "%d", arcSec);
+      *numericReply = false;
+    }
   } else return false;
 
   return true;
@@ -35,11 +35,14 @@ void Mount::init() {
   nvKey = nv().kv().computeKey("MOUNT_SETTINGS");
   if (!nv().kv().getOrInit(nvKey, settings)) { DLF("WRN: Nv, init failed for MOUNT_SETTINGS"); }
 
+  nvKeyBacklashReverse = nv().kv().computeKey("MOUNT_BACKLASH_REV");
+  if (!nv().kv().getOrInit(nvKeyBacklashReverse, backlashReverse)) { DLF("WRN: Nv, init failed for MOUNT_BACKLASH_REV"); }
+
   // get the main axes ready
   delay(100);
   if (!axis1.init(&motor1)) { initError.driver = true; DLF("ERR: Mount::init(), no motion controller for Axis1!"); } else {
-    axis1.setBacklash(settings.backlash.axis1);
     axis1.setMotionLimitsCheck(false);
+    axis1.setBacklash(settings.backlash.axis1, backlashReverse.axis1);
     if (AXIS1_POWER_DOWN == ON) axis1.setPowerDownTime(AXIS1_POWER_DOWN_TIME);
     #ifdef AXIS1_ENCODER_ORIGIN
       uint32_t origin = UINT32_MAX;
@@ -52,8 +55,8 @@ void Mount::init() {
 
   delay(100);
   if (!axis2.init(&motor2)) { initError.driver = true; DLF("ERR: Mount::init(), no motion controller for Axis2!"); } else {
-    axis2.setBacklash(settings.backlash.axis2);
     axis2.setMotionLimitsCheck(false);
+    axis2.setBacklash(settings.backlash.axis2, backlashReverse.axis2);
     if (AXIS2_POWER_DOWN == ON) axis2.setPowerDownTime(AXIS2_POWER_DOWN_TIME);
     #ifdef AXIS2_ENCODER_ORIGIN
       uint32_t origin = UINT32_MAX;
@@ -63,6 +66,21 @@ void Mount::init() {
       }
     #endif
   }
+
+  #if MOTION_GROUP == ON
+    // poll both axes from one task so tracking, guide, and goto rate changes reach the motors together
+    if (!initError.driver) {
+      motionGroup.add(&axis1);
+      motionGroup.add(&axis2);
+      if (!motionGroup.init()) { DLF("WRN: Mount::init(), no motion group, the axes are polled separately"); }
+    }
+  #endif
+}
+
+// apply the backlash settings to both axes
+void Mount::applyBacklash() {
+  axis1.setBacklash(settings.backlash.axis1, backlashReverse.axis1);
+  axis2.setBacklash(settings.backlash.axis2, backlashReverse.axis2);
 }
 
 void Mount::begin() {
@@ -388,7 +406,7 @@ void Mount::update() {
     if (!guide.activeAxis1() || guide.state == GU_PULSE_GUIDE) {
       f1 = trackingRateAxis1;
       if (transform.mountType != ALTAZM && transform.mountType != ALTALT) {
-        f1 += guide.rateAxis1;
+        f1 += guide.rateAxis1 + guide.rateCorrectionAxis1;
         #if AXIS1_PEC == ON
           f1 += pec.rate;
         #endif
@@ -398,7 +416,7 @@ void Mount::update() {
 
     if (!guide.activeAxis2() || guide.state == GU_PULSE_GUIDE) {
       f2 = trackingRateAxis2;
-      if (transform.mountType != ALTAZM && transform.mountType != ALTALT)  f2 += guide.rateAxis2;
+      if (transform.mountType != ALTAZM && transform.mountType != ALTALT)  f2 += guide.rateAxis2 + guide.rateCorrectionAxis2;
       axis2.setSynchronizedFrequency(siderealToRadF(f2)*SIDEREAL_RATIO_F*site.getSiderealRatio());
     }
 
@@ -515,9 +533,12 @@ void Mount::poll() {
   behind.d -= trackingRateOffsetRadsDec;
 
   // apply non-equatorial guide rate offset to equatorial coordinates
-  if (guide.state == GU_PULSE_GUIDE && (transform.mountType == ALTAZM || transform.mountType == ALTALT)) {
-    float trackingRateGuideRadsRA = siderealToRad(guide.rateAxis1)*timeInSeconds*2.0;
-    float trackingRateGuideRadsDec = siderealToRad(guide.rateAxis2)*timeInSeconds*2.0;
+  if ((guide.state == GU_PULSE_GUIDE || guide.activeRateCorrection()) && (transform.mountType == ALTAZM || transform.mountType == ALTALT)) {
+    float guideRateRA = guide.rateCorrectionAxis1;
+    float guideRateDec = guide.rateCorrectionAxis2;
+    if (guide.state == GU_PULSE_GUIDE) { guideRateRA += guide.rateAxis1; guideRateDec += guide.rateAxis2; }
+    float trackingRateGuideRadsRA = siderealToRad(guideRateRA)*timeInSeconds*2.0;
+    float trackingRateGuideRadsDec = siderealToRad(guideRateDec)*timeInSeconds*2.0;
     ahead.h += trackingRateGuideRadsRA;
     behind.h -= trackingRateGuideRadsRA;
     ahead.d += trackingRateGuideRadsDec;
@@ -7,6 +7,7 @@
 #ifdef MOUNT_PRESENT
 
 #include "../../lib/axis/Axis.h"
+#include "../../lib/axis/MotionGroup.h"
 #include "../../libApp/commands/ProcessCmds.h"
 #include "coordinates/Transform.h"
 #include "home/Home.h"
@@ -121,6 +122,12 @@ class Mount {
 
     MountSettings settings = {RC_DEFAULT, { 0, 0 }, MOUNT_SUBTYPE};
 
+    // backlash taken up on reversals toward reverse in radians, negative for the same as settings.backlash
+    Backlash backlashReverse = { -1.0F, -1.0F };
+
+    // apply the backlash settings to both axes
+    void applyBacklash();
+
   private:
     // alternate tracking rate calculation method
     float ztr(float a);
@@ -136,6 +143,11 @@ class Mount {
     TrackingState trackingState = TS_NONE;
 
     uint32_t nvKey;
+    uint32_t nvKeyBacklashReverse;
+
+    #if MOTION_GROUP == ON
+      MotionGroup motionGroup;
+    #endif
 
     #if MOUNT_COORDS_MEMORY == ON
       uint32_t nvKeyLastA, nvKeyLastB;
@@ -277,37 +277,27 @@ CommandError Goto::setTarget(Coordinate *coords, PierSideSelect pierSideSelect,
     if (current.pierSide == PIER_SIDE_WEST) pierSideSelect = PSS_WEST_ONLY; else pierSideSelect = PSS_EAST_ONLY;
   }
 
-  bool eastReachable, westReachable;
-
   target.pierSide = current.pierSide;
   target.a1Correction = 0.0;
 
-  double axis1TargetCorrectionE = 0.0;
-  double axis1TargetCorrectionW = 0.0;
-  e = limits.validateTarget(&target, &eastReachable, &westReachable, &axis1TargetCorrectionE, &axis1TargetCorrectionW, isGoto);
+  PierSideCandidate candidates[2];
+  e = limits.solvePierSide(&target, candidates, isGoto);
   if (e != CE_NONE) return e;
 
-  double a1, a2, a1e, a1w, a2e, a2w;
-  a1 = axis1.getInstrumentCoordinate();
-  a2 = axis2.getInstrumentCoordinate();
-
-  target.pierSide = PIER_SIDE_EAST;
-  transform.mountToInstrument(&target, &a1e, &a2e);
-  a1e += axis1TargetCorrectionE;
+  PierSideCandidate *east = &candidates[0];
+  PierSideCandidate *west = &candidates[1];
+  if (east->pierSide != PIER_SIDE_EAST) { east = &candidates[1]; west = &candidates[0]; }
 
-  target.pierSide = PIER_SIDE_WEST;
-  transform.mountToInstrument(&target, &a1w, &a2w);
-  a1w += axis1TargetCorrectionW;
+  bool eastReachable = east->reachable;
+  bool westReachable = west->reachable;
+  double eastDistance = east->distance;
+  double westDistance = west->distance;
 
   target.pierSide = current.pierSide;
 
-  VF("MSG: Mount, set-target current axis1 "); V(radToDeg(a1)); VF(" and axis2 "); VL(radToDeg(a2));
-  VF("MSG: Mount, set-target targetE axis1 "); V(radToDeg(a1e)); VF(" and axis2 "); VL(radToDeg(a2e));
-  VF("MSG: Mount, set-target targetW axis1 "); V(radToDeg(a1w)); VF(" and axis2 "); VL(radToDeg(a2w));
-
-  double eastDistance, westDistance;
-  if (dist(a1, a1e) > dist(a2, a2e)) eastDistance = dist(a1, a1e); else eastDistance = dist(a2, a2e);
-  if (dist(a1, a1w) > dist(a2, a2w)) westDistance = dist(a1, a1w); else westDistance = dist(a2, a2w);
+  VF("MSG: Mount, set-target current axis1 "); V(radToDeg(axis1.getInstrumentCoordinate())); VF(" and axis2 "); VL(radToDeg(axis2.getInstrumentCoordinate()));
+  VF("MSG: Mount, set-target targetE axis1 "); V(radToDeg(east->a1)); VF(" and axis2 "); VL(radToDeg(east->a2));
+  VF("MSG: Mount, set-target targetW axis1 "); V(radToDeg(west->a1)); VF(" and axis2 "); VL(radToDeg(west->a2));
 
   if (mount.isHome() && transform.mountType == GEM) {
     VLF("MSG: Mount, set-target destination from home based on HA");
@@ -363,8 +353,8 @@ CommandError Goto::setTarget(Coordinate *coords, PierSideSelect pierSideSelect,
   }
 
   // adjust Axis1 coordinate range as needed to allow going past +/-180 degrees
-  if (target.pierSide == PIER_SIDE_EAST) target.a1Correction = axis1TargetCorrectionE;
-  if (target.pierSide == PIER_SIDE_WEST) target.a1Correction = axis1TargetCorrectionW;
+  if (target.pierSide == PIER_SIDE_EAST) target.a1Correction = east->a1Correction;
+  if (target.pierSide == PIER_SIDE_WEST) target.a1Correction = west->a1Correction;
 
   transform.observedPlaceToMount(&target);
   if (transform.mountType == ALTAZM) transform.horToEqu(&target); else
@@ -595,11 +585,15 @@ void Goto::poll() {
   if (transform.isEquatorial() && MOUNT_HORIZON_AVOIDANCE == ON) {
     if (site.locationEx.latitude.absval > degToRad(10.0)) {
       static float last_a2 = 0;
-      Coordinate coords = mount.getMountPosition(CR_MOUNT_ALT);
+      #if LIMIT_HORIZON_MASK == ON
+        Coordinate coords = mount.getMountPosition(CR_MOUNT_HOR);
+      #else
+        Coordinate coords = mount.getMountPosition(CR_MOUNT_ALT);
+      #endif
       float a2 = site.locationEx.latitude.sign*coords.d;
 
       // range 0.2 to 1.0, where a larger distance has less slowdown effect
-      float slowdownFactor = radToDeg(coords.a - limits.settings.altitude.min)/(SLEW_ACCELERATION_DIST*2.0);
+      float slowdownFactor = radToDeg(coords.a - limits.minAltitude(coords.z))/(SLEW_ACCELERATION_DIST*2.0);
 
       // constrain
       if (slowdownFactor > 1.0F) slowdownFactor = 1.0F;
@@ -729,6 +723,12 @@ float Goto::usPerStepLowerLimit() {
   float r_us_axis1 = r_us/axis1.getStepsPerStepSlewing();
   float r_us_axis2 = r_us/axis2.getStepsPerStepSlewing();
 
+  // the motors may have a fixed limit too, the step scheduler's tick rate for example
+  float limitAxis1 = axis1.motor->getFrequencyLimitSteps();
+  float limitAxis2 = axis2.motor->getFrequencyLimitSteps();
+  if (limitAxis1 > 0.0F && r_us_axis1 < 1000000.0F/limitAxis1) r_us_axis1 = 1000000.0F/limitAxis1;
+  if (limitAxis2 > 0.0F && r_us_axis2 < 1000000.0F/limitAxis2) r_us_axis2 = 1000000.0F/limitAxis2;
+
   // average in axis2 step rate scaling for drives where the reduction ratio isn't equal
   r_us = (1.0F/(1.0F/r_us_axis1 + 1.0F/r_us_axis2))*2.0F;
 
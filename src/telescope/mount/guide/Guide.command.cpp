@@ -50,6 +50,24 @@ bool Guide::command(char *reply, char *command, char *parameter, bool *suppressF
       } else *commandError = CE_PARAM_FORM;
     } else
 
+    // :Mv[s]n.n,[s]n.n,n#  Set continuous guide rate correction, where the first two values are the Axis1 (+West)
+    //            and Axis2 (+North) rates in arc-seconds per second and the last is the validity period in milliseconds
+    //            Return: 0 on failure
+    //                    1 on success
+    if (command[1] == 'v') {
+      char *conv_end;
+      float rate1 = strtod(parameter, &conv_end);
+      if (&parameter[0] == conv_end || conv_end[0] != ',') { *commandError = CE_PARAM_FORM; return true; }
+      char *parameter2 = &conv_end[1];
+      float rate2 = strtod(parameter2, &conv_end);
+      if (parameter2 == conv_end || conv_end[0] != ',') { *commandError = CE_PARAM_FORM; return true; }
+      char *parameter3 = &conv_end[1];
+      long timeoutMs = strtol(parameter3, &conv_end, 10);
+      if (parameter3 == conv_end || conv_end[0] != 0) { *commandError = CE_PARAM_FORM; return true; }
+      if (timeoutMs < 0) { *commandError = CE_PARAM_RANGE; return true; }
+      *commandError = setRateCorrection(rate1, rate2, timeoutMs);
+    } else
+
     // :Mw#       Move Telescope West at current guide rate
     //            Returns: Nothing
     if (command[1] == 'w' && parameter[0] == 0) {
@@ -79,6 +97,45 @@ bool Guide::command(char *reply, char *command, char *parameter, bool *suppressF
     if (command[1] == 'p' && parameter[0] == 0) {
       *commandError = startSpiral(settings.axis1RateSelect, GUIDE_SPIRAL_TIME_LIMIT*1000);
       *numericReply = false;
+    } else
+
+    // :Mp?#      Get sPiral search status
+    //            Returns: s,n# where s is 0 for none, 1 moving, or 2 dwelling and n is the current point
+    if (command[1] == 'p' && parameter[0] == '?' && parameter[1] == 0) {
+      sprintf(reply, "%d,%d", (int)spiralSearchState, spiralSearchPoint);
+      *numericReply = false;
+    } else
+
+    // :MpN#      Move to the Next sPiral search point
+    //            Return: 0 on failure (not dwelling or out of points)
+    //                    1 on success
+    if (command[1] == 'p' && parameter[0] == 'N' && parameter[1] == 0) {
+      *commandError = spiralSearchNext();
+    } else
+
+    // :MpQ#      Quit the sPiral search remaining at the current point
+    //            Return: 0 on failure (no search active)
+    //                    1 on success
+    if (command[1] == 'p' && parameter[0] == 'Q' && parameter[1] == 0) {
+      if (spiralSearchState == SS_NONE) *commandError = CE_0; else stopSpiralSearch();
+    } else
+
+    // :Mp[f],[o],[n]#  Start a stepped sPiral search with field of view f in arc-minutes (1 to 600,) overlap o in percent
+    //            (0 to 90,) and dwell time n in milliseconds (0 to 600000, 0 holds each point until :MpN# is received)
+    //            Return: 0 on failure
+    //                    1 on success
+    if (command[1] == 'p') {
+      char *conv_end;
+      float fov = strtod(parameter, &conv_end);
+      if (&parameter[0] == conv_end || conv_end[0] != ',') { *commandError = CE_PARAM_FORM; return true; }
+      char *parameter2 = &conv_end[1];
+      float overlap = strtod(parameter2, &conv_end);
+      if (parameter2 == conv_end || conv_end[0] != ',') { *commandError = CE_PARAM_FORM; return true; }
+      char *parameter3 = &conv_end[1];
+      long dwellMs = strtol(parameter3, &conv_end, 10);
+      if (parameter3 == conv_end || conv_end[0] != 0) { *commandError = CE_PARAM_FORM; return true; }
+      if (dwellMs < 0) { *commandError = CE_PARAM_RANGE; return true; }
+      *commandError = startSpiralSearch(fov, overlap, dwellMs);
     } else return false;
   } else
 
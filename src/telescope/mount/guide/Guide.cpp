@@ -82,6 +82,12 @@ CommandError Guide::startAxis1(GuideAction guideAction, GuideRateSelect rateSele
 void Guide::stopAxis1(GuideAction stopDirection, bool abort) {
   if (state == GU_HOME_GUIDE && !abort) { this->abort(); return; }
 
+  if (abort && rateCorrectionAxis1 != 0.0F) {
+    rateCorrectionAxis1 = 0.0F;
+    if (!activeRateCorrection()) rateCorrectionDone();
+    mount.update();
+  }
+
   if (guideActionAxis1 > GA_BREAK) {
     if (stopDirection != GA_BREAK && guideActionAxis1 != stopDirection && guideActionAxis1 != GA_HOME) return;
     if (rateAxis1 == 0.0F) {
@@ -143,6 +149,12 @@ CommandError Guide::startAxis2(GuideAction guideAction, GuideRateSelect rateSele
 void Guide::stopAxis2(GuideAction stopDirection, bool abort) {
   if (state == GU_HOME_GUIDE && !abort) { this->abort(); return; }
 
+  if (abort && rateCorrectionAxis2 != 0.0F) {
+    rateCorrectionAxis2 = 0.0F;
+    if (!activeRateCorrection()) rateCorrectionDone();
+    mount.update();
+  }
+
   if (guideActionAxis2 > GA_BREAK) {
     if (stopDirection != GA_BREAK && guideActionAxis2 != stopDirection && guideActionAxis2 != GA_HOME) return;
     if (rateAxis2 == 0.0F) {
@@ -150,6 +162,9 @@ void Guide::stopAxis2(GuideAction stopDirection, bool abort) {
       if (abort) axis2.autoSlewAbort(); else axis2.autoSlewStop();
     } else {
       VLF("MSG: Guide, Axis2 stopped");
+      #if GUIDE_BACKLASH_PREDICT == ON
+        if (state == GU_PULSE_GUIDE && !abort) backlashPredictAxis2(rateAxis2 > 0.0F ? 1 : -1);
+      #endif
       guideActionAxis2 = GA_NONE;
       rateAxis2 = 0.0F;
       mount.update();
@@ -186,6 +201,91 @@ CommandError Guide::startSpiral(GuideRateSelect rateSelect, unsigned long guideT
   return CE_NONE;
 }
 
+// start a spiral search that steps between dwell points spaced by the field of view (in arc-minutes)
+// less the overlap (in percent), for dwellMs = 0 each point is held until spiralSearchNext() is called
+CommandError Guide::startSpiralSearch(float fovArcMin, float overlapPercent, unsigned long dwellMs) {
+  if (fovArcMin < 1.0F || fovArcMin > 600.0F) return CE_PARAM_RANGE;
+  if (overlapPercent < 0.0F || overlapPercent > 90.0F) return CE_PARAM_RANGE;
+  if (dwellMs > 600000UL) return CE_PARAM_RANGE;
+  if (state == GU_SPIRAL_GUIDE || guideActionAxis1 != GA_NONE || guideActionAxis2 != GA_NONE) return CE_SLEW_IN_MOTION;
+  CommandError e = validate(0, GA_SPIRAL); if (e != CE_NONE) return e;
+
+  spiralSearchStep = arcsecToRad(fovArcMin*60.0F*(1.0F - overlapPercent/100.0F));
+  spiralSearchDwellMs = dwellMs;
+  spiralSearchPoint = 0;
+
+  // each point is placed relative to the origin so the overshoot stopping a move doesn't add up across the spiral,
+  // Axis1 steps are larger away from the equator, keep the aspect reasonable near the pole
+  Coordinate location = mount.getMountPosition(CR_MOUNT);
+  spiralSearchStepAxis1 = spiralSearchStep/fmax(fabs(cos(location.a2)), 0.1);
+  spiralSearchStartTime = millis();
+  spiralSearchOriginAxis1 = axis1.getInstrumentCoordinate();
+  spiralSearchOriginAxis2 = axis2.getInstrumentCoordinate();
+  spiralSearchPositionAxis1 = 0;
+  spiralSearchPositionAxis2 = 0;
+
+  VF("MSG: Guide, spiral search started with "); V(radToArcsec(spiralSearchStep)); VLF(" arc-sec steps");
+
+  // the starting position is the first point
+  spiralSearchState = SS_DWELL;
+  spiralSearchDwellStartTime = millis();
+  return CE_NONE;
+}
+
+// move to the next spiral search point, only while dwelling
+CommandError Guide::spiralSearchNext() {
+  if (spiralSearchState != SS_DWELL) return CE_SLEW_IN_MOTION;
+  if (guideActionAxis1 != GA_NONE || guideActionAxis2 != GA_NONE) return CE_SLEW_IN_MOTION;
+  if (spiralSearchPoint >= GUIDE_SPIRAL_SEARCH_POINTS_MAX) { stopSpiralSearch(); return CE_PARAM_RANGE; }
+
+  // a square spiral of single axis moves one step long, legs are 1, 1, 2, 2, 3, 3... steps
+  // and take the directions axis1 forward, axis2 forward, axis1 reverse, axis2 reverse in turn
+  int point = spiralSearchPoint + 1;
+  int leg = 0;
+  int legPoints = 1;
+  while (point > legPoints) { point -= legPoints; leg++; legPoints = leg/2 + 1; }
+  spiralSearchAxis = (leg % 2 == 0) ? 1 : 2;
+  GuideAction guideAction = (leg % 4 < 2) ? GA_FORWARD : GA_REVERSE;
+
+  GuideRateSelect rateSelect = spiralSearchAxis == 1 ? settings.axis1RateSelect : settings.axis2RateSelect;
+  if (rateSelect < GR_4X)       rateSelect = GR_4X;
+  if (rateSelect > GR_HALF_MAX) rateSelect = GR_HALF_MAX;
+
+  // the next point on the grid
+  int direction = guideAction == GA_FORWARD ? 1 : -1;
+  double step = spiralSearchAxis == 1 ? spiralSearchStepAxis1 : spiralSearchStep;
+  if (spiralSearchAxis == 1) {
+    spiralSearchTarget = spiralSearchOriginAxis1 + (spiralSearchPositionAxis1 + direction)*step;
+  } else {
+    spiralSearchTarget = spiralSearchOriginAxis2 + (spiralSearchPositionAxis2 + direction)*step;
+  }
+
+  // the move is ended by reaching the point, the time limit is only a backstop
+  float rate = rateSelectToRate(rateSelect, spiralSearchAxis);
+  unsigned long timeLimit = (step/siderealToRad(rate))*3000.0 + 2000UL;
+
+  CommandError e;
+  if (spiralSearchAxis == 1) e = startAxis1(guideAction, rateSelect, timeLimit); else e = startAxis2(guideAction, rateSelect, timeLimit);
+  if (e != CE_NONE) { stopSpiralSearch(); return e; }
+
+  if (spiralSearchAxis == 1) spiralSearchPositionAxis1 += direction; else spiralSearchPositionAxis2 += direction;
+
+  spiralSearchPoint++;
+  spiralSearchState = SS_MOVING;
+  return CE_NONE;
+}
+
+// stop the spiral search and remain at the current point
+void Guide::stopSpiralSearch() {
+  if (spiralSearchState == SS_NONE) return;
+
+  if (spiralSearchState == SS_MOVING) {
+    if (spiralSearchAxis == 1) stopAxis1(); else stopAxis2();
+  }
+  VF("MSG: Guide, spiral search stopped at point "); VL(spiralSearchPoint);
+  spiralSearchState = SS_NONE;
+}
+
 // start guide home (for use with home switches)
 CommandError Guide::startHome() {
   #if GOTO_FEATURE == ON
@@ -217,18 +317,85 @@ CommandError Guide::startHome() {
   return CE_NONE;
 }
 
-// stop both axes of guide
+// set continuous guide rate corrections in arc-seconds per second, applied on top of tracking
+// until replaced or until timeoutMs has elapsed
+CommandError Guide::setRateCorrection(float axis1ArcsecPerSec, float axis2ArcsecPerSec, unsigned long timeoutMs) {
+  if (fabs(axis1ArcsecPerSec) > GUIDE_RATE_CORRECTION_MAX || fabs(axis2ArcsecPerSec) > GUIDE_RATE_CORRECTION_MAX) return CE_PARAM_RANGE;
+  if (timeoutMs == 0 || timeoutMs > GUIDE_RATE_CORRECTION_TIMEOUT_MAX) return CE_PARAM_RANGE;
+
+  if (axis1ArcsecPerSec == 0.0F && axis2ArcsecPerSec == 0.0F) { stopRateCorrection(); return CE_NONE; }
+
+  if (state == GU_SPIRAL_GUIDE || state == GU_HOME_GUIDE || state == GU_HOME_GUIDE_ABORT) return CE_SLEW_IN_MOTION;
+  #if GOTO_FEATURE == ON
+    if (goTo.state != GS_NONE) return CE_SLEW_IN_SLEW;
+  #endif
+  if (limits.isError()) return CE_SLEW_ERR_OUTSIDE_LIMITS;
+
+  // full validation only at the start of a correction stream, updates are expected at 10 to 50Hz
+  if (!activeRateCorrection()) {
+    CommandError e = validate(0, GA_NONE);
+    if (e != CE_NONE) return e;
+
+    backlashEnableControl(false);
+    axis1.setPowerDownOverrideTime(300000UL);
+    axis2.setPowerDownOverrideTime(300000UL);
+
+    pierSide = mount.getMountPosition(CR_MOUNT).pierSide;
+    VLF("MSG: Guide, rate correction started");
+  }
+
+  // arc-seconds per second to x sidereal
+  rateCorrectionAxis1 = axis1ArcsecPerSec/(15.0F*SIDEREAL_RATIO_F);
+  rateCorrectionAxis2 = axis2ArcsecPerSec/(15.0F*SIDEREAL_RATIO_F);
+  if (pierSide == PIER_SIDE_WEST) rateCorrectionAxis2 = -rateCorrectionAxis2;
+
+  rateCorrectionFinishTime = millis() + timeoutMs;
+  mount.update();
+
+  return CE_NONE;
+}
+
+// stop any continuous guide rate correction
+void Guide::stopRateCorrection() {
+  if (!activeRateCorrection()) return;
+
+  VLF("MSG: Guide, rate correction stopped");
+  rateCorrectionAxis1 = 0.0F;
+  rateCorrectionAxis2 = 0.0F;
+  rateCorrectionDone();
+  mount.update();
+}
+
+// undo the backlash and power down changes made at the start of a rate correction stream
+void Guide::rateCorrectionDone() {
+  // a pulse guide in progress still wants them
+  if (state == GU_PULSE_GUIDE) return;
+
+  backlashEnableControl(true);
+  axis1.setPowerDownOverrideTime(0);
+  axis2.setPowerDownOverrideTime(0);
+}
+
+// stop both axes of guide, and any test driving a motor
 void Guide::stop() {
+  axis1.motor->abortTests();
+  axis2.motor->abortTests();
+  stopSpiralSearch();
+  stopRateCorrection();
   stopAxis1();
   stopAxis2();
 }
 
-// abort both axes of guide
+// abort both axes of guide, and any test driving a motor
 void Guide::abort() {
+  axis1.motor->abortTests();
+  axis2.motor->abortTests();
   if (state == GU_HOME_GUIDE) {
     VLF("MSG: Mount, aborting home guide");
     state = GU_HOME_GUIDE_ABORT;
   }
+  spiralSearchState = SS_NONE;
+  stopRateCorrection();
   stopAxis1(GA_BREAK, true);
   stopAxis2(GA_BREAK, true);
 }
@@ -293,6 +460,14 @@ bool Guide::validAxis1(GuideAction guideAction) {
     }
     if (location.a1 > axis1.getLimitMax()) return false;
   }
+
+  #if LIMIT_KEEP_OUT == ON
+    // from inside a keep-out zone only allow motion that leads out
+    if (limits.isKeepOutError()) {
+      if (guideAction == GA_SPIRAL) return false;
+      if (!limits.isKeepOutExit(1, guideAction == GA_FORWARD ? 1 : -1)) return false;
+    }
+  #endif
   return true;
 }
 
@@ -319,6 +494,16 @@ bool Guide::validAxis2(GuideAction guideAction) {
     if (fabs(location.a2) > degToRad(75.0)) return false;
   }
 
+  #if LIMIT_KEEP_OUT == ON
+    // from inside a keep-out zone only allow motion that leads out, on the west pier side guides move axis2 in reverse
+    if (limits.isKeepOutError()) {
+      if (guideAction == GA_SPIRAL) return false;
+      int direction = guideAction == GA_FORWARD ? 1 : -1;
+      if (pierSide == PIER_SIDE_WEST) direction = -direction;
+      if (!limits.isKeepOutExit(2, direction)) return false;
+    }
+  #endif
+
   return true;
 }
 
@@ -347,14 +532,14 @@ CommandError Guide::validate(int axis, GuideAction guideAction) {
   if (axis == 1 || guideAction == GA_SPIRAL) {
     if (!validAxis1(guideAction)) return CE_SLEW_ERR_OUTSIDE_LIMITS;
     if (settings.axis1RateSelect < 3) {
-      if (limits.isError() || axis1.motionError(DIR_BOTH)) return CE_SLEW_ERR_OUTSIDE_LIMITS;
+      if (limits.isError(false) || axis1.motionError(DIR_BOTH)) return CE_SLEW_ERR_OUTSIDE_LIMITS;
     }
   }
 
   if (axis == 2 || guideAction == GA_SPIRAL) {
     if (!validAxis2(guideAction)) return CE_SLEW_ERR_OUTSIDE_LIMITS;
     if (settings.axis2RateSelect < 3) {
-      if (limits.isError() || axis2.motionError(DIR_BOTH)) return CE_SLEW_ERR_OUTSIDE_LIMITS;
+      if (limits.isError(false) || axis2.motionError(DIR_BOTH)) return CE_SLEW_ERR_OUTSIDE_LIMITS;
     }
   }
 
@@ -428,7 +613,39 @@ void Guide::spiralPoll() {
   axis2.setFrequencySlew(siderealToRadF(customRateAxis2));
 }
 
+// end spiral search moves once they reach their point and advance from dwell points when timed
+void Guide::spiralSearchPoll() {
+  if (spiralSearchState == SS_MOVING) {
+    GuideAction guideAction = spiralSearchAxis == 1 ? guideActionAxis1 : guideActionAxis2;
+    if (guideAction > GA_BREAK) {
+      // position relative to the sky, the origin moves with tracking
+      float trackingRate = spiralSearchAxis == 1 ? mount.trackingRateAxis1 : mount.trackingRateAxis2;
+      double coordinate = spiralSearchAxis == 1 ? axis1.getInstrumentCoordinate() : axis2.getInstrumentCoordinate();
+      double tracked = siderealToRad(trackingRate)*SIDEREAL_RATIO*((long)(millis() - spiralSearchStartTime)/1000.0);
+      double remaining = spiralSearchTarget + tracked - coordinate;
+      if (guideAction == GA_REVERSE) remaining = -remaining;
+      if (remaining <= 0.0) {
+        if (spiralSearchAxis == 1) stopAxis1(); else stopAxis2();
+      }
+    } else
+    if (guideActionAxis1 == GA_NONE && guideActionAxis2 == GA_NONE) {
+      VF("MSG: Guide, spiral search dwell at point "); VL(spiralSearchPoint);
+      spiralSearchState = SS_DWELL;
+      spiralSearchDwellStartTime = millis();
+    }
+  } else
+
+  if (spiralSearchState == SS_DWELL && spiralSearchDwellMs > 0) {
+    if ((long)(millis() - spiralSearchDwellStartTime) >= (long)spiralSearchDwellMs) spiralSearchNext();
+  }
+}
+
 void Guide::poll() {
+  // expire continuous guide rate corrections that weren't refreshed in time
+  if (activeRateCorrection() && (long)(millis() - rateCorrectionFinishTime) >= 0) stopRateCorrection();
+
+  spiralSearchPoll();
+
   // just return if no guide is active
   if (state == GU_NONE) return;
 
@@ -474,11 +691,27 @@ void Guide::poll() {
   if (guideActionAxis1 == GA_NONE && guideActionAxis2 == GA_NONE) state = GU_NONE;
 }
 
+#if GUIDE_BACKLASH_PREDICT == ON
+  // record an Axis2 pulse-guide direction (1 or -1) and take up backlash the other way if guides keep reversing
+  void Guide::backlashPredictAxis2(int8_t direction) {
+    if (direction == -lastPulseDirectionAxis2) {
+      if (pulseReversalsAxis2 < 255) pulseReversalsAxis2++;
+    } else pulseReversalsAxis2 = 0;
+    lastPulseDirectionAxis2 = direction;
+
+    if (pulseReversalsAxis2 >= GUIDE_BACKLASH_PREDICT_REVERSALS) axis2.setBacklashPreload(-direction);
+  }
+#endif
+
 // enables or disables backlash for the GUIDE_DISABLE_BACKLASH option
 void Guide::backlashEnableControl(bool enable) {
   #if GUIDE_DISABLE_BACKLASH == ON
-    axis1.setBacklash(enable ? mount.settings.backlash.axis1 : 0.0F);
-    axis2.setBacklash(enable ? mount.settings.backlash.axis2 : 0.0F);
+    if (enable) {
+      mount.applyBacklash();
+    } else {
+      axis1.setBacklash(0.0F);
+      axis2.setBacklash(0.0F);
+    }
   #else
     UNUSED(enable);
   #endif
@@ -16,9 +16,31 @@
 
 // default time for spiral guides is 103.4 seconds
 #define GUIDE_SPIRAL_TIME_LIMIT 103.4
+
+// maximum continuous guide rate correction in arc-seconds per second
+#ifndef GUIDE_RATE_CORRECTION_MAX
+#define GUIDE_RATE_CORRECTION_MAX 30.0F
+#endif
+
+// maximum validity period for a continuous guide rate correction in milliseconds
+#ifndef GUIDE_RATE_CORRECTION_TIMEOUT_MAX
+#define GUIDE_RATE_CORRECTION_TIMEOUT_MAX 10000UL
+#endif
+
+// maximum number of points visited by a spiral search
+#ifndef GUIDE_SPIRAL_SEARCH_POINTS_MAX
+#define GUIDE_SPIRAL_SEARCH_POINTS_MAX 225
+#endif
+
+// consecutive Axis2 pulse-guide reversals before backlash is taken up ahead of the next one
+#ifndef GUIDE_BACKLASH_PREDICT_REVERSALS
+#define GUIDE_BACKLASH_PREDICT_REVERSALS 2
+#endif
+
 enum GuideState: uint8_t       {GU_NONE, GU_PULSE_GUIDE, GU_GUIDE, GU_SPIRAL_GUIDE, GU_HOME_GUIDE, GU_HOME_GUIDE_ABORT};
 enum GuideRateSelect: uint8_t  {GR_QUARTER, GR_HALF, GR_1X, GR_2X, GR_4X, GR_8X, GR_20X, GR_48X, GR_HALF_MAX, GR_MAX, GR_CUSTOM};
 enum GuideAction: uint8_t      {GA_NONE, GA_BREAK, GA_FORWARD, GA_REVERSE, GA_SPIRAL, GA_HOME };
+enum SpiralSearchState: uint8_t {SS_NONE, SS_MOVING, SS_DWELL};
 
 #pragma pack(1)
 #define GuideSettingsSize 3
@@ -55,6 +77,30 @@ class Guide {
     // start guide home (for use with home switches)
     CommandError startHome();
 
+    // start a spiral search that steps between dwell points spaced by the field of view (in arc-minutes)
+    // less the overlap (in percent), for dwellMs = 0 each point is held until spiralSearchNext() is called
+    CommandError startSpiralSearch(float fovArcMin, float overlapPercent, unsigned long dwellMs);
+
+    // move to the next spiral search point, only while dwelling
+    CommandError spiralSearchNext();
+
+    // stop the spiral search and remain at the current point
+    void stopSpiralSearch();
+
+    // spiral search progress
+    SpiralSearchState spiralSearchState = SS_NONE;
+    int spiralSearchPoint = 0;
+
+    // set continuous guide rate corrections in arc-seconds per second, applied on top of tracking
+    // until replaced or until timeoutMs has elapsed
+    CommandError setRateCorrection(float axis1ArcsecPerSec, float axis2ArcsecPerSec, unsigned long timeoutMs);
+
+    // stop any continuous guide rate correction
+    void stopRateCorrection();
+
+    // returns true if a continuous guide rate correction is happening
+    inline bool activeRateCorrection() { return rateCorrectionAxis1 != 0.0F || rateCorrectionAxis2 != 0.0F; }
+
     // stop both axes of guide
     void stop();
 
@@ -79,14 +125,23 @@ class Guide {
 
     void spiralPoll();
 
+    void spiralSearchPoll();
+
     // enables or disables backlash for the GUIDE_DISABLE_BACKLASH option
     void backlashEnableControl(bool enable);
 
+    // restores backlash and the power down once a rate correction stream ends
+    void rateCorrectionDone();
+
     GuideState state = GU_NONE;
 
     float rateAxis1 = 0.0F;
     float rateAxis2 = 0.0F;
 
+    // continuous guide rate corrections (in x sidereal)
+    float rateCorrectionAxis1 = 0.0F;
+    float rateCorrectionAxis2 = 0.0F;
+
     GuideSettings settings = { GR_HALF, GR_20X, GR_20X };
 
   private:
@@ -111,6 +166,14 @@ class Guide {
     // start axis2 movement
     void axis2AutoSlew(GuideAction guideAction);
 
+    #if GUIDE_BACKLASH_PREDICT == ON
+      // record an Axis2 pulse-guide direction (1 or -1) and take up backlash the other way if guides keep reversing
+      void backlashPredictAxis2(int8_t direction);
+
+      int8_t lastPulseDirectionAxis2 = 0;
+      uint8_t pulseReversalsAxis2 = 0;
+    #endif
+
     GuideRateSelect spiralGuideRateSelect = GR_20X;
     
     GuideAction guideActionAxis1 = GA_NONE;
@@ -127,6 +190,20 @@ class Guide {
     unsigned long guideFinishTimeAxis1 = 0;
     unsigned long guideFinishTimeAxis2 = 0;
 
+    unsigned long rateCorrectionFinishTime = 0;
+
+    float spiralSearchStep = 0.0F;
+    unsigned long spiralSearchDwellMs = 0;
+    unsigned long spiralSearchDwellStartTime = 0;
+    uint8_t spiralSearchAxis = 1;
+    unsigned long spiralSearchStartTime = 0;
+    double spiralSearchOriginAxis1 = 0.0;   // instrument coordinates the search started from
+    double spiralSearchOriginAxis2 = 0.0;
+    double spiralSearchStepAxis1 = 0.0;     // Axis1 step, wider away from the equator
+    int spiralSearchPositionAxis1 = 0;      // grid position of the current point, in steps from the origin
+    int spiralSearchPositionAxis2 = 0;
+    double spiralSearchTarget = 0.0;        // instrument coordinate of the current point, less tracking since the start
+
     uint32_t nvKey;
 };
 
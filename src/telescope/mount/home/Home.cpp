@@ -310,8 +310,7 @@ CommandError Home::reset(bool fullReset, bool authoritative) {
 
   mount.captureNominalIndexPositions();
 
-  axis1.setBacklash(mount.settings.backlash.axis1);
-  axis2.setBacklash(mount.settings.backlash.axis2);
+  mount.applyBacklash();
 
   axis1.setFrequencySlew(degToRadF(0.1F));
   axis2.setFrequencySlew(degToRadF(0.1F));
@@ -23,6 +23,25 @@ bool Limits::command(char *reply, char *command, char *parameter, bool *suppress
       *numericReply = false;
     } else
 
+    #if LIMIT_HORIZON_MASK == ON
+      // :GhM[n]#   Get horizon Mask entries starting at azimuth n (0 to 359 degrees)
+      //            Returns: DD.D[,DD.D...]# up to eight entries in degrees
+      if (command[1] == 'h' && parameter[0] == 'M') {
+        char *conv_end;
+        long index = strtol(&parameter[1], &conv_end, 10);
+        if (&parameter[1] == conv_end || conv_end[0] != 0) { *commandError = CE_PARAM_FORM; return true; }
+        if (index < 0 || index >= HORIZON_MASK_SIZE) { *commandError = CE_PARAM_RANGE; return true; }
+        reply[0] = 0;
+        for (int i = index; i < index + 8 && i < HORIZON_MASK_SIZE; i++) {
+          char value[8];
+          sprintF(value, "%0.1f", getHorizonMask(i));
+          if (i != index) strcat(reply, ",");
+          strcat(reply, value);
+        }
+        *numericReply = false;
+      } else
+    #endif
+
     // :Go#       Get Overhead Limit
     //            Returns: DD*#
     //            The highest elevation above the horizon that the telescope will goto
@@ -31,6 +50,17 @@ bool Limits::command(char *reply, char *command, char *parameter, bool *suppress
       *numericReply=false;
     } else
 
+    #if LIMIT_KEEP_OUT == ON
+      // :GXEK[n]#  Get keep-out model parameter [n] (0 to 9)
+      //            Returns: n# in mm
+      if (command[1] == 'X' && parameter[0] == 'E' && parameter[1] == 'K' && parameter[3] == 0) {
+        int n = parameter[2] - '0';
+        if (n < 0 || n >= KEEP_OUT_PARAMETERS) { *commandError = CE_PARAM_RANGE; return true; }
+        sprintf(reply, "%d", getKeepOut(n));
+        *numericReply = false;
+      } else
+    #endif
+
     // :GXE[m]#   Get Other Limit [m]
     //            Returns: n#
     if (command[1] == 'X' && parameter[0] == 'E' && parameter[2] == 0) {
@@ -43,12 +73,56 @@ bool Limits::command(char *reply, char *command, char *parameter, bool *suppress
         case 'B': sprintf(reply, "%ld",lroundf(radToDegF(axis1.getLimitMax())/15.0F)); break;   // RA west or +Az limit, in hours
         case 'C': sprintf(reply, "%ld",lroundf(radToDegF(axis2.getLimitMin()))); break;         // Dec south or -Alt limit, in degrees
         case 'D': sprintf(reply, "%ld",lroundf(radToDegF(axis2.getLimitMax()))); break;         // Dec north or +Alt limit, in degrees
+        #if LIMIT_LOOKAHEAD != OFF
+          case 'L': sprintf(reply, "%ld,%c", lroundf(getTimeToLimit()), getTimeToLimitType()); break; // seconds to limit and type
+        #endif
         default: return false;
       }
     } else return false;
   } else
   
   if (command[0] == 'S') {
+    #if LIMIT_HORIZON_MASK == ON
+      //  :ShMC#
+      //            Clear the horizon Mask
+      //            Return: 0 on failure
+      //                    1 on success
+      if (command[1] == 'h' && parameter[0] == 'M' && parameter[1] == 'C' && parameter[2] == 0) {
+        for (int i = 0; i < HORIZON_MASK_SIZE; i++) setHorizonMask(i, HORIZON_MASK_NONE*0.5F);
+        writeHorizonMask();
+      } else
+
+      //  :ShM[n],[sDD.D][,sDD.D...]#
+      //            Set horizon Mask entries starting at azimuth n (0 to 359 degrees) to altitudes in degrees
+      //            (-64.0 to 63.5, in 0.5 degree steps)
+      //            Return: 0 on failure
+      //                    1 on success
+      if (command[1] == 'h' && parameter[0] == 'M') {
+        char *conv_end;
+        long start = strtol(&parameter[1], &conv_end, 10);
+        if (&parameter[1] == conv_end || conv_end[0] != ',') { *commandError = CE_PARAM_FORM; return true; }
+        char *values = conv_end;
+
+        // check every entry first so a bad command leaves the mask (and NV) unchanged
+        long index = start;
+        while (conv_end[0] == ',') {
+          char *value = &conv_end[1];
+          float altitude = strtod(value, &conv_end);
+          if (value == conv_end) { *commandError = CE_PARAM_FORM; break; }
+          if (index < 0 || index >= HORIZON_MASK_SIZE || altitude < -64.0F || altitude > 63.5F) { *commandError = CE_PARAM_RANGE; break; }
+          index++;
+        }
+        if (*commandError == CE_NONE && conv_end[0] != 0) *commandError = CE_PARAM_FORM;
+
+        if (*commandError == CE_NONE) {
+          index = start;
+          conv_end = values;
+          while (conv_end[0] == ',') setHorizonMask(index++, strtod(&conv_end[1], &conv_end));
+          writeHorizonMask();
+        }
+      } else
+    #endif
+
     //  :Sh[sDD]#
     //            Set the elevation lower limit
     //            Return: 0 on failure
@@ -77,6 +151,18 @@ bool Limits::command(char *reply, char *command, char *parameter, bool *suppress
       } else *commandError = CE_PARAM_FORM;
     } else
 
+    #if LIMIT_KEEP_OUT == ON
+      //  :SXEK[n],[mm]#
+      //            Set keep-out model parameter [n] (0 to 9) to [mm] (0 to 5000) and rebuild the keep-out map
+      //            Return: 0 on failure or 1 on success
+      if (command[1] == 'X' && parameter[0] == 'E' && parameter[1] == 'K' && parameter[3] == ',') {
+        char *conv_end;
+        long mm = strtol(&parameter[4], &conv_end, 10);
+        if (&parameter[4] == conv_end || conv_end[0] != 0) *commandError = CE_PARAM_FORM; else
+          *commandError = setKeepOut(parameter[2] - '0', mm);
+      } else
+    #endif
+
     //  :SXE9,[n]#
     //  :SXEA,[n]#
     //            Set meridian limit east (9) or west (A) to value [n] in minutes
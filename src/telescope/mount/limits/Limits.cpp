@@ -26,11 +26,72 @@ void Limits::init() {
   settings.pastMeridianE = constrain(settings.pastMeridianE, degToRadF(-360), degToRadF(360));
   settings.pastMeridianW = constrain(settings.pastMeridianW, degToRadF(-360), degToRadF(360));
 
+  #if LIMIT_HORIZON_MASK == ON
+    for (int c = 0; c < HORIZON_MASK_SIZE/HORIZON_MASK_CHUNK_SIZE; c++) {
+      char name[] = "LIMIT_HMASK0";
+      name[11] = '0' + c;
+      nvKeyHorizonMask[c] = nv().kv().computeKey(name);
+      horizonMaskChanged[c] = false;
+
+      int8_t *chunk = &horizonMask[c*HORIZON_MASK_CHUNK_SIZE];
+      uint16_t len = 0;
+      if (nv().kv().get(nvKeyHorizonMask[c], chunk, HORIZON_MASK_CHUNK_SIZE, len) != KvPartition::Status::Ok || len != HORIZON_MASK_CHUNK_SIZE) {
+        VF("MSG: Limits, horizon mask "); V(c); VLF(" init");
+        memset(chunk, HORIZON_MASK_NONE, HORIZON_MASK_CHUNK_SIZE);
+        if (nv().kv().put(nvKeyHorizonMask[c], chunk, HORIZON_MASK_CHUNK_SIZE) != KvPartition::Status::Ok) { DF("WRN: Nv, init failed for "); DL(name); }
+      }
+    }
+  #endif
+
+  #if LIMIT_KEEP_OUT == ON
+    keepOutInit();
+  #endif
+
   // start limit monitor task
   VF("MSG: Mount, start limits monitor task (rate 100ms priority 2)... ");
   if (tasks.add(100, 0, true, 2, limitsWrapper, "MtLimit")) { VLF("success"); } else { VLF("FAILED!"); }
 }
 
+// minimum altitude (in radians) at the given azimuth (in radians,) the higher of the horizon limit and mask
+float Limits::minAltitude(double azimuth) {
+  #if LIMIT_HORIZON_MASK == ON
+    // linear interpolation between the two nearest entries
+    float z = radToDegF(azimuth);
+    if (z < 0.0F) z += 360.0F;
+    int i = (int)z;
+    float f = z - i;
+    if (i < 0 || i >= HORIZON_MASK_SIZE) { i = 0; f = 0.0F; }
+    int j = i + 1; if (j >= HORIZON_MASK_SIZE) j = 0;
+
+    float mask = degToRadF((horizonMask[i] + (horizonMask[j] - horizonMask[i])*f)*0.5F);
+    if (mask > settings.altitude.min) return mask;
+  #else
+    UNUSED(azimuth);
+  #endif
+  return settings.altitude.min;
+}
+
+#if LIMIT_HORIZON_MASK == ON
+  // set horizon mask entry at index (0 to 359 degrees azimuth,) altitude in degrees
+  CommandError Limits::setHorizonMask(int index, float altitude) {
+    if (index < 0 || index >= HORIZON_MASK_SIZE) return CE_PARAM_RANGE;
+    if (altitude < -64.0F || altitude > 63.5F) return CE_PARAM_RANGE;
+
+    horizonMask[index] = (int8_t)lroundf(altitude*2.0F);
+    horizonMaskChanged[index/HORIZON_MASK_CHUNK_SIZE] = true;
+    return CE_NONE;
+  }
+
+  // write any changed horizon mask entries to NV
+  void Limits::writeHorizonMask() {
+    for (int c = 0; c < HORIZON_MASK_SIZE/HORIZON_MASK_CHUNK_SIZE; c++) {
+      if (!horizonMaskChanged[c]) continue;
+      nv().kv().put(nvKeyHorizonMask[c], &horizonMask[c*HORIZON_MASK_CHUNK_SIZE], HORIZON_MASK_CHUNK_SIZE);
+      horizonMaskChanged[c] = false;
+    }
+  }
+#endif
+
 // target coordinate check ahead of sync, goto, etc.
 CommandError Limits::validateTarget(Coordinate *coords, bool isGoto) {
   bool eastReachable, westReachable;
@@ -102,106 +163,127 @@ CommandError Limits::setInstrumentCoordinate(uint8_t axisNumber, double value, b
 
 // target coordinate check ahead of sync, goto, etc.
 CommandError Limits::validateTarget(Coordinate *coords, bool *eastReachable, bool *westReachable, double *eastCorrection, double *westCorrection, bool isGoto) {
-  if (flt(coords->a, settings.altitude.min)) return CE_SLEW_ERR_BELOW_HORIZON;
-  if (fgt(coords->a, settings.altitude.max)) return CE_SLEW_ERR_ABOVE_OVERHEAD;
+  PierSideCandidate candidates[2];
+  CommandError e = solvePierSide(coords, candidates, isGoto);
+
+  for (int i = 0; i < 2; i++) {
+    if (candidates[i].pierSide == PIER_SIDE_EAST) {
+      *eastReachable = candidates[i].reachable;
+      *eastCorrection = candidates[i].a1Correction;
+    } else {
+      *westReachable = candidates[i].reachable;
+      *westCorrection = candidates[i].a1Correction;
+    }
+  }
 
-  double a1e, a2e, a1w, a2w;
+  return e;
+}
 
-  PierSide lastPierSide = coords->pierSide; 
-  coords->pierSide = PIER_SIDE_EAST;
-  transform.mountToInstrument(coords, &a1e, &a2e);
-  coords->pierSide = PIER_SIDE_WEST;
-  transform.mountToInstrument(coords, &a1w, &a2w);
-  coords->pierSide = lastPierSide;
+// solve for the target on both pier sides in one pass, candidates are returned ranked with
+// any reachable ones first and then by shortest slew distance
+CommandError Limits::solvePierSide(Coordinate *coords, PierSideCandidate candidates[2], bool isGoto) {
+  candidates[0] = { PIER_SIDE_EAST, false, 0.0, 0.0, 0.0, 0.0 };
+  candidates[1] = { PIER_SIDE_WEST, false, 0.0, 0.0, 0.0, 0.0 };
 
-  float eastLimitMin = axis1.getLimitMin();
-  float eastLimitMax = axis1.getLimitMax();
-  float westLimitMin = axis1.getLimitMin();
-  float westLimitMax = axis1.getLimitMax();
+  #if LIMIT_HORIZON_MASK == ON
+    Coordinate horizon = *coords;
+    transform.equToHor(&horizon);
+    if (flt(coords->a, minAltitude(horizon.z))) return CE_SLEW_ERR_BELOW_HORIZON;
+  #else
+    if (flt(coords->a, settings.altitude.min)) return CE_SLEW_ERR_BELOW_HORIZON;
+  #endif
+  if (fgt(coords->a, settings.altitude.max)) return CE_SLEW_ERR_ABOVE_OVERHEAD;
+
+  float limitMin = axis1.getLimitMin();
+  float limitMax = axis1.getLimitMax();
+  bool sectorGearGoto = false;
 
   if (AXIS1_SECTOR_GEAR == ON) {
-    if (isGoto) {
-      *eastReachable = true;
-      *westReachable = true;
-      return CE_NONE;
-    } else {
-      eastLimitMin = -Deg180;
-      eastLimitMax = Deg180;
-      westLimitMin = -Deg180;
-      westLimitMax = Deg180;
+    if (isGoto) sectorGearGoto = true; else {
+      limitMin = -Deg180;
+      limitMax = Deg180;
     }
   }
 
-  if (transform.mountType == GEM) {
-    if (-limits.settings.pastMeridianE > eastLimitMin) eastLimitMin = -limits.settings.pastMeridianE;
-    if (limits.settings.pastMeridianW < westLimitMax) westLimitMax = limits.settings.pastMeridianW;
-    westLimitMin += Deg180;
-    westLimitMax += Deg180;
-  }
-
   double a1 = axis1.getInstrumentCoordinate();
+  double a2 = axis2.getInstrumentCoordinate();
+
+  PierSide lastPierSide = coords->pierSide;
+
+  for (int i = 0; i < 2; i++) {
+    PierSideCandidate *c = &candidates[i];
+
+    coords->pierSide = c->pierSide;
+    transform.mountToInstrument(coords, &c->a1, &c->a2);
+
+    if (sectorGearGoto) c->reachable = true; else {
+      float sideLimitMin = limitMin;
+      float sideLimitMax = limitMax;
+      if (transform.mountType == GEM) {
+        if (c->pierSide == PIER_SIDE_EAST) {
+          if (-settings.pastMeridianE > sideLimitMin) sideLimitMin = -settings.pastMeridianE;
+        } else {
+          if (settings.pastMeridianW < sideLimitMax) sideLimitMax = settings.pastMeridianW;
+          sideLimitMin += Deg180;
+          sideLimitMax += Deg180;
+        }
+      }
 
-  bool inRange;
-  if ((a1e >= eastLimitMin) && (a1e <= eastLimitMax)) inRange = true; else inRange = false;
-
-  if ((a1e + Deg360 > eastLimitMin) && (a1e + Deg360 < eastLimitMax) && inRange && (dist(a1, a1e) > dist(a1, a1e + Deg360))) {
-    a1e += Deg360;
-    *eastCorrection = Deg360;
-    VF("MSG: Mount, validate destination east axis1 best normalized to "); VL(radToDeg(a1e));
-  } else
-  if ((a1e - Deg360 > eastLimitMin) && (a1e - Deg360 < eastLimitMax) && inRange && (dist(a1, a1e) > dist(a1, a1e - Deg360))) {
-    a1e -= Deg360;
-    *eastCorrection = -Deg360;
-    VF("MSG: Mount, validate destination east axis1 best normalized to "); VL(radToDeg(a1e));
-  }
+      // of the axis1 wraps that fall within limits use the one closest to the current position
+      bool inRange = c->a1 >= sideLimitMin && c->a1 <= sideLimitMax;
+      double a1Target = c->a1;
+      for (int wrap = -1; wrap <= 1; wrap += 2) {
+        double a1Wrapped = c->a1 + wrap*Deg360;
+        if (a1Wrapped > sideLimitMin && a1Wrapped < sideLimitMax && (!inRange || dist(a1, a1Wrapped) < dist(a1, a1Target))) {
+          a1Target = a1Wrapped;
+          c->a1Correction = wrap*Deg360;
+          inRange = true;
+        }
+      }
+      c->a1 = a1Target;
+      c->reachable = inRange;
 
-  if ((a1e + Deg360 > eastLimitMin) && (a1e + Deg360 < eastLimitMax) && !inRange) {
-    a1e += Deg360;
-    *eastCorrection = Deg360;
-    VF("MSG: Mount, validate destination east axis1 normalized to "); VL(radToDeg(a1e));
-  } else
-  if ((a1e - Deg360 > eastLimitMin) && (a1e - Deg360 < eastLimitMax) && !inRange) {
-    a1e -= Deg360;
-    *eastCorrection = -Deg360;
-    VF("MSG: Mount, validate destination east axis1 normalized to "); VL(radToDeg(a1e));
-  }
+      VF("MSG: Mount, validate "); V(c->pierSide == PIER_SIDE_EAST ? "east" : "west"); VF(" target axis1 ");
+      V(radToDeg(sideLimitMin)); VF(" < "); V(radToDeg(c->a1)); VF(" < "); V(radToDeg(sideLimitMax));
+      if (c->reachable) { VLF(" TRUE"); } else { VLF(" FALSE"); }
+    }
 
-  if ((a1w >= westLimitMin) && (a1w <= westLimitMax)) inRange = true; else inRange = false;
-
-  if ((a1w + Deg360 > westLimitMin) && (a1w + Deg360 < westLimitMax) && inRange && (dist(a1, a1w) > dist(a1, a1w + Deg360))) {
-    a1w += Deg360;
-    *westCorrection = Deg360;
-    VF("MSG: Mount, validate destination best west axis1 normalized to "); VL(radToDeg(a1w));
-  } else
-  if ((a1w - Deg360 > westLimitMin) && (a1w - Deg360 < westLimitMax) && inRange && (dist(a1, a1w) > dist(a1, a1w - Deg360))) {
-    a1w -= Deg360;
-    *westCorrection = -Deg360;
-    VF("MSG: Mount, validate destination best west axis1 normalized to "); VL(radToDeg(a1w));
-  }
+    #if LIMIT_KEEP_OUT == ON
+      if (c->reachable && isKeepOut(c->a1, c->a2)) {
+        c->reachable = false;
+        VLF("MSG: Mount, validate target in keep-out zone");
+      } else
+      // pier flips pass through the home position so only same side gotos follow a straight path
+      if (c->reachable && isGoto && c->pierSide == transform.instrumentToMount(a1, a2).pierSide && isKeepOutPath(a1, a2, c->a1, c->a2)) {
+        c->reachable = false;
+        VLF("MSG: Mount, validate path to target crosses keep-out zone");
+      } else
+      // and from inside a zone only a straight path is known to lead out
+      if (c->reachable && isGoto && c->pierSide != transform.instrumentToMount(a1, a2).pierSide && isKeepOut(a1, a2)) {
+        c->reachable = false;
+        VLF("MSG: Mount, validate pier flip from inside keep-out zone");
+      }
+    #endif
 
-  if ((a1w + Deg360 > westLimitMin) && (a1w + Deg360 < westLimitMax) && !inRange) {
-    a1w += Deg360;
-    *westCorrection = Deg360;
-    VF("MSG: Mount, validate destination west axis1 normalized to "); VL(radToDeg(a1w));
-  } else
-  if ((a1w - Deg360 > westLimitMin) && (a1w - Deg360 < westLimitMax) && !inRange) {
-    a1w -= Deg360;
-    *westCorrection = -Deg360;
-    VF("MSG: Mount, validate destination west axis1 normalized to "); VL(radToDeg(a1w));
+    c->distance = dist(a1, c->a1);
+    if (dist(a2, c->a2) > c->distance) c->distance = dist(a2, c->a2);
   }
 
-  *eastReachable = a1e >= eastLimitMin && a1e <= eastLimitMax;
-  *westReachable = a1w >= westLimitMin && a1w <= westLimitMax;
+  coords->pierSide = lastPierSide;
+
+  if ((!candidates[0].reachable && candidates[1].reachable) ||
+      (candidates[0].reachable == candidates[1].reachable && candidates[1].distance < candidates[0].distance)) {
+    PierSideCandidate swap = candidates[0];
+    candidates[0] = candidates[1];
+    candidates[1] = swap;
+  }
 
-  VF("MSG: Mount, validate east target axis1 "); V(radToDeg(eastLimitMin)); VF(" < "); V(radToDeg(a1e)); VF(" < "); V(radToDeg(eastLimitMax));
-  if (*eastReachable) { VLF(" TRUE"); } else { VLF(" FALSE"); }
-  VF("MSG: Mount, validate west target axis1 "); V(radToDeg(westLimitMin)); VF(" < "); V(radToDeg(a1w)); VF(" < "); V(radToDeg(westLimitMax));
-  if (*westReachable) { VLF(" TRUE"); } else { VLF(" FALSE"); }
+  if (sectorGearGoto) return CE_NONE;
 
-  if (!*eastReachable && !*westReachable) {
+  if (!candidates[0].reachable) {
     VLF("MSG: Mount, validate target outside limits");
-    *eastCorrection = 0.0;
-    *westCorrection = 0.0;
+    candidates[0].a1Correction = 0.0;
+    candidates[1].a1Correction = 0.0;
     return CE_SLEW_ERR_OUTSIDE_LIMITS;
   }
 
@@ -224,7 +306,13 @@ CommandError Limits::validateTarget(Coordinate *coords, bool *eastReachable, boo
 }
 
 // true if an error exists
-bool Limits::isError() {
+bool Limits::isError(bool keepOut) {
+  #if LIMIT_KEEP_OUT == ON
+    if (keepOut && keepOutError) return true;
+  #else
+    UNUSED(keepOut);
+  #endif
+
   return initError.nv ||
          initError.value ||
          initError.tls ||
@@ -259,7 +347,7 @@ uint8_t Limits::errorCode() {
   enum GeneralErrors: uint8_t {
   ERR_NONE, ERR_MOTOR_FAULT, ERR_ALT_MIN, ERR_LIMIT_SENSE, ERR_DEC, ERR_AZM,
   ERR_UNDER_POLE, ERR_MERIDIAN, ERR_SYNC, ERR_PARK, ERR_GOTO_SYNC, ERR_UNSPECIFIED,
-  ERR_ALT_MAX, ERR_WEATHER_INIT, ERR_SITE_INIT, ERR_NV_INIT};
+  ERR_ALT_MAX, ERR_WEATHER_INIT, ERR_SITE_INIT, ERR_NV_INIT, ERR_KEEP_OUT};
 
   // priority highest to lowest
   if (mount.motorFault()) return (uint8_t)ERR_MOTOR_FAULT;
@@ -276,6 +364,9 @@ uint8_t Limits::errorCode() {
     if (error.limit.axis2.max) return (uint8_t)ERR_ALT_MAX;
   }
   if (error.meridian.east || error.meridian.west) return (uint8_t)ERR_MERIDIAN;
+  #if LIMIT_KEEP_OUT == ON
+    if (keepOutError) return (uint8_t)ERR_KEEP_OUT;
+  #endif
   if (initError.nv || initError.value) return (uint8_t)ERR_NV_INIT;
   if (initError.tls) return (uint8_t)ERR_SITE_INIT;
   if (initError.weather) return (uint8_t)ERR_WEATHER_INIT;
@@ -312,7 +403,11 @@ void Limits::poll() {
 
   LimitsError lastError = error;
 
-  Coordinate current = mount.getMountPosition(CR_MOUNT_ALT);
+  #if LIMIT_HORIZON_MASK == ON
+    Coordinate current = mount.getMountPosition(CR_MOUNT_HOR);
+  #else
+    Coordinate current = mount.getMountPosition(CR_MOUNT_ALT);
+  #endif
 
   #if TRACK_AUTOSTART == OFF && TRACK_WITHOUT_LIMITS == OFF
     if (!limitsEnabled && mount.isTracking()) {
@@ -323,7 +418,7 @@ void Limits::poll() {
 
   if (limitsEnabled && guide.state != GU_HOME_GUIDE && guide.state != GU_HOME_GUIDE_ABORT) {
     // overhead and horizon limits
-    if (current.a < settings.altitude.min && limitsDisablePeriodDs == 0) error.altitude.min = true; else error.altitude.min = false;
+    if (current.a < minAltitude(current.z) && limitsDisablePeriodDs == 0) error.altitude.min = true; else error.altitude.min = false;
 
     if (fabs(settings.altitude.max - Deg90) > OneArcSec) {
       if (current.a > settings.altitude.max && limitsDisablePeriodDs == 0) error.altitude.max = true; else error.altitude.max = false;
@@ -425,6 +520,21 @@ void Limits::poll() {
       error.limit.axis2.max = true;
     } else error.limit.axis2.max = false;
 
+    #if LIMIT_KEEP_OUT == ON
+      // pier and tripod keep-out zones
+      bool keepOut = isKeepOut(axis1.getInstrumentCoordinate(), axis2.getInstrumentCoordinate());
+      if (keepOut && !keepOutError) {
+        DLF("WRN: Mount, limits keep-out zone entered");
+        stop();
+      } else
+      // guides and gotos from inside a zone are only allowed if they lead out, tracking is checked here
+      if (keepOut && mount.isTracking() && !isKeepOutTrackingExit()) {
+        VLF("MSG: Mount, tracking stopped inside keep-out zone");
+        mount.tracking(false);
+      }
+      keepOutError = keepOut;
+    #endif
+
   } else {
     error.altitude.min = false;
     error.altitude.max = false;
@@ -434,6 +544,9 @@ void Limits::poll() {
     error.limit.axis2.max = false;
     error.meridian.east = false;
     error.meridian.west = false;
+    #if LIMIT_KEEP_OUT == ON
+      keepOutError = false;
+    #endif
   }
 
   // min and max limit switches
@@ -497,8 +610,103 @@ void Limits::poll() {
       (!lastError.limit.axis1.max && error.limit.axis1.max) ||
       (!lastError.limit.axis2.min && error.limit.axis2.min) ||
       (!lastError.limit.axis2.max && error.limit.axis2.max)) stop();
+
+  #if LIMIT_LOOKAHEAD != OFF
+    // projecting ahead is relatively expensive so only do it every 5 seconds
+    static int lookAheadCount = 0;
+    if (++lookAheadCount >= 50) { lookAheadCount = 0; lookAhead(); }
+  #endif
 }
 
+#if LIMIT_LOOKAHEAD != OFF
+  // seconds until tracking reaches a limit, or -1 if none is reached within the look-ahead period
+  float Limits::getTimeToLimit() {
+    if (timeToLimit < 0.0F) return -1.0F;
+    float seconds = timeToLimit - (long)(millis() - timeToLimitTime)/1000.0F;
+    if (seconds < 0.0F) seconds = 0.0F;
+    return seconds;
+  }
+
+  // project tracking forward to find the time until a limit is reached
+  void Limits::lookAhead() {
+    timeToLimitTime = millis();
+    timeToLimit = -1.0F;
+    timeToLimitType = 'N';
+
+    if (!limitsEnabled || !mount.isTracking()) return;
+    #if GOTO_FEATURE == ON
+      if (goTo.state != GS_NONE) return;
+    #endif
+
+    // the same rates Mount::poll() applies to the equatorial coordinates
+    lookAheadRateH = siderealToRad(mount.trackingRate - mount.trackingRateOffsetRA);
+    lookAheadRateD = siderealToRad(mount.trackingRateOffsetDec);
+
+    Coordinate start = mount.getMountPosition(CR_MOUNT_EQU);
+    if (transform.mountType == ALTAZM) {
+      Coordinate startHor = start;
+      transform.equToHor(&startHor);
+      lookAheadZ = startHor.z;
+    }
+    if (projectedLimit(&start, 0.0F)) { timeToLimit = 0.0F; return; }
+
+    // coarse search then bisect down to about 1/8000th of the look-ahead period
+    const float step = LIMIT_LOOKAHEAD/32.0F;
+    for (int i = 1; i <= 32; i++) {
+      float seconds = step*i;
+      if (projectedLimit(&start, seconds)) {
+        float lo = seconds - step;
+        float hi = seconds;
+        for (int j = 0; j < 8; j++) {
+          float mid = (lo + hi)/2.0F;
+          if (projectedLimit(&start, mid)) hi = mid; else lo = mid;
+        }
+        projectedLimit(&start, hi);
+        timeToLimit = hi;
+        return;
+      }
+    }
+  }
+
+  // true if the start position projected forward by seconds of tracking is past a limit
+  bool Limits::projectedLimit(Coordinate *start, float seconds) {
+    Coordinate future = *start;
+    future.h += lookAheadRateH*seconds;
+    future.d += lookAheadRateD*seconds;
+
+    transform.equToHor(&future);
+    if (transform.mountType == ALTAZM) {
+      // the azimuth wraps at +/-180 degrees but axis1 doesn't, so move axis1 by the change in azimuth
+      double change = future.z - lookAheadZ;
+      if (change > Deg180) change -= Deg360; else if (change < -Deg180) change += Deg360;
+      future.a1 = start->a1 + change;
+      future.a2 = future.a;
+    } else
+    if (transform.mountType == ALTALT) { transform.equToAa(&future); future.a1 = future.aa1; future.a2 = future.aa2; } else
+    { future.a1 = future.h; future.a2 = future.d; }
+
+    if (future.a < minAltitude(future.z)) { timeToLimitType = 'H'; return true; }
+    if (fabs(settings.altitude.max - Deg90) > OneArcSec && future.a > settings.altitude.max) { timeToLimitType = 'O'; return true; }
+
+    if (transform.mountType == GEM) {
+      if (future.pierSide == PIER_SIDE_EAST && future.h < -settings.pastMeridianE) { timeToLimitType = 'M'; return true; }
+      if (future.pierSide == PIER_SIDE_WEST && future.h > settings.pastMeridianW) { timeToLimitType = 'M'; return true; }
+    } else {
+      if (future.pierSide == PIER_SIDE_WEST) future.a1 += Deg180;
+    }
+
+    #if AXIS1_SECTOR_GEAR == OFF
+      if (flt(future.a1, axis1.getLimitMin()) || fgt(future.a1, axis1.getLimitMax())) { timeToLimitType = '1'; return true; }
+    #endif
+    #if AXIS2_TANGENT_ARM == OFF
+      if (flt(future.a2, axis2.getLimitMin()) || fgt(future.a2, axis2.getLimitMax())) { timeToLimitType = '2'; return true; }
+    #endif
+
+    timeToLimitType = 'N';
+    return false;
+  }
+#endif
+
 Limits limits;
 
 #endif
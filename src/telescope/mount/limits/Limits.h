@@ -22,7 +22,41 @@
 #define LIMIT_MERIDIAN_WEST 15.0F
 #endif
 
+#if LIMIT_HORIZON_MASK == ON
+  // one entry per degree of azimuth, starting at North and increasing to the East
+  #define HORIZON_MASK_SIZE 360
+  // entries are int8_t altitudes in 0.5 degree units, the lowest value effectively disables the mask
+  #define HORIZON_MASK_NONE -128
+  // NV storage is split into entries small enough for any KV partition
+  #define HORIZON_MASK_CHUNK_SIZE 120
+#endif
+
+#if LIMIT_KEEP_OUT == ON
+  // keep-out map covers axis1 and axis2 instrument coordinates over -180 to 180 degrees
+  #define KEEP_OUT_CELL_DEG 5
+  #define KEEP_OUT_CELLS (360/KEEP_OUT_CELL_DEG)
+  #define KEEP_OUT_PARAMETERS 10
+  // cells looked ahead for a way out of a keep-out zone
+  #define KEEP_OUT_EXIT_CELLS 6
+#endif
+
 #pragma pack(1)
+#if LIMIT_KEEP_OUT == ON
+// keep-out model dimensions in mm relative to the axes intersection, a zero radius or length disables that part
+typedef struct KeepOutSettings {
+  int16_t pierRadius;
+  int16_t pierTop;      // distance of the top of the pier below the axes intersection
+  int16_t tripodRadius;
+  int16_t tripodTop;    // distance of the top of the tripod legs below the axes intersection
+  int16_t otaOffset;    // distance from the RA axis to the OTA axis
+  int16_t otaFront;     // OTA length ahead of the Dec axis
+  int16_t otaRear;      // OTA and camera length behind the Dec axis
+  int16_t otaRadius;
+  int16_t cwLength;     // counterweight shaft and weights length from the RA axis
+  int16_t cwRadius;
+} KeepOutSettings;
+#endif
+
 typedef struct AltitudeLimits {
   float min; // in radians
   float max; // in radians
@@ -57,6 +91,16 @@ typedef struct LimitsError {
   MerdianError    meridian;
 } LimitsError;
 
+// one pier side solution for a target
+typedef struct PierSideCandidate {
+  PierSide pierSide;
+  bool reachable;
+  double a1;            // instrument coordinate, in radians with a1Correction applied
+  double a2;            // instrument coordinate, in radians
+  double a1Correction;  // axis1 wrap normalization, 0 or +/-360 degrees in radians
+  double distance;      // slew distance, the larger of the axis1 and axis2 moves in radians
+} PierSideCandidate;
+
 class Limits {
   public:
     void init();
@@ -67,12 +111,67 @@ class Limits {
     CommandError validateTarget(Coordinate *coords, bool isGoto);
     CommandError validateTarget(Coordinate *coords, bool *eastReachable, bool *westReachable, double *eastCorrection, double *westCorrection, bool isGoto);
 
+    // solve for the target on both pier sides in one pass, candidates are returned ranked with
+    // any reachable ones first and then by shortest slew distance
+    CommandError solvePierSide(Coordinate *coords, PierSideCandidate candidates[2], bool isGoto);
+
     // validate and apply an instrument coordinate change for a mount axis
     CommandError validateInstrumentCoordinate(uint8_t axisNumber, double value, bool bypass = false);
     CommandError setInstrumentCoordinate(uint8_t axisNumber, double value, bool bypass = false);
 
+    // minimum altitude (in radians) at the given azimuth (in radians,) the higher of the horizon limit and mask
+    float minAltitude(double azimuth);
+
+    #if LIMIT_HORIZON_MASK == ON
+    // get horizon mask entry at index (0 to 359 degrees azimuth,) altitude in degrees
+    inline float getHorizonMask(int index) { return horizonMask[index]*0.5F; }
+
+    // set horizon mask entry at index (0 to 359 degrees azimuth,) altitude in degrees
+    // the entry is not saved to NV until writeHorizonMask() is called
+    CommandError setHorizonMask(int index, float altitude);
+
+    // write any changed horizon mask entries to NV
+    void writeHorizonMask();
+    #endif
+
+    #if LIMIT_LOOKAHEAD != OFF
+    // seconds until tracking reaches a limit, or -1 if none is reached within the look-ahead period
+    float getTimeToLimit();
+
+    // type of limit that tracking will reach: H horizon, O overhead, M meridian, 1 axis1, 2 axis2, or N none
+    inline char getTimeToLimitType() { return timeToLimitType; }
+    #endif
+
+    #if LIMIT_KEEP_OUT == ON
+    // true if the instrument coordinates (in radians) fall in a keep-out zone
+    bool isKeepOut(double a1, double a2);
+
+    // true if the straight path between instrument coordinates (in radians) crosses a keep-out zone
+    bool isKeepOutPath(double a1, double a2, double b1, double b2);
+
+    // true if the mount is in a keep-out zone
+    inline bool isKeepOutError() { return keepOutError; }
+
+    // true if moving instrument axis (1 or 2) in direction (1 or -1) from the current position leaves
+    // the keep-out zone within KEEP_OUT_EXIT_CELLS cells
+    bool isKeepOutExit(int axis, int direction);
+
+    // true if tracking from the current position leaves the keep-out zone within KEEP_OUT_EXIT_CELLS cells
+    bool isKeepOutTrackingExit();
+
+    // get keep-out model parameter n (0 to 9) in mm
+    int getKeepOut(int n);
+
+    // set keep-out model parameter n (0 to 9) in mm, the keep-out map is rebuilt
+    CommandError setKeepOut(int n, int mm);
+
+    // rebuild the keep-out map from the model for the current site latitude
+    void keepOutBuild();
+    #endif
+
     // true if an limit related error is exists
-    bool isError();
+    // \param keepOut: false to leave out the keep-out zone, for motion that has been checked to lead out
+    bool isError(bool keepOut = true);
 
     // true if an error exists that impacts goto safety
     bool isGotoError();
@@ -115,6 +214,40 @@ class Limits {
     void stop();
     void stopAxis1(GuideAction stopDirection = GA_BREAK);
     void stopAxis2(GuideAction stopDirection = GA_BREAK);
+    #if LIMIT_LOOKAHEAD != OFF
+    // project tracking forward to find the time until a limit is reached
+    void lookAhead();
+
+    // true if the start position projected forward by seconds of tracking is past a limit
+    bool projectedLimit(Coordinate *start, float seconds);
+
+    float lookAheadRateH = 0.0F;    // in radians per second
+    float lookAheadRateD = 0.0F;    // in radians per second
+    double lookAheadZ = 0.0;        // azimuth at the start of the projection, in radians
+    float timeToLimit = -1.0F;      // in seconds
+    char timeToLimitType = 'N';
+    unsigned long timeToLimitTime = 0;
+    #endif
+
+    #if LIMIT_KEEP_OUT == ON
+    // load the keep-out model and build the map
+    void keepOutInit();
+
+    // set keep-out model parameter n in mm without checks
+    void keepOutPut(int n, int16_t value);
+
+    // true if the OTA or counterweights at this equatorial position and pier side touch the pier or tripod
+    bool keepOutCollision(double h, double d, PierSide pierSide, float margin);
+
+    // true if the point (in mm, x east, y north, z up) is inside the pier or tripod grown by clearance
+    bool keepOutInside(float x, float y, float z, float clearance);
+
+    KeepOutSettings keepOutSettings = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    uint8_t keepOutMap[(KEEP_OUT_CELLS*KEEP_OUT_CELLS + 7)/8];
+    bool keepOutError = false;
+    uint32_t nvKeyKeepOut;
+    #endif
+
     // get least distance between coordinates
     inline double dist(double a, double b) { if (a > b) return a - b; else return b - a; }
 
@@ -123,6 +256,12 @@ class Limits {
 
     int limitsDisablePeriodDs = 0; // in deciseconds (0.1s)
 
+    #if LIMIT_HORIZON_MASK == ON
+    int8_t horizonMask[HORIZON_MASK_SIZE];
+    bool horizonMaskChanged[HORIZON_MASK_SIZE/HORIZON_MASK_CHUNK_SIZE];
+    uint32_t nvKeyHorizonMask[HORIZON_MASK_SIZE/HORIZON_MASK_CHUNK_SIZE];
+    #endif
+
     uint32_t nvKey;
 };
 
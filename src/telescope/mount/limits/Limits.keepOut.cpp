@@ -0,0 +1,189 @@
+//--------------------------------------------------------------------------------------------------
+// telescope mount limits, pier/tripod keep-out zones
+
+#include "Limits.h"
+
+#if defined(MOUNT_PRESENT) && LIMIT_KEEP_OUT == ON
+
+#include "../../../lib/tasks/OnTask.h"
+#include "../../../lib/nv/Nv.h"
+
+#include "../Mount.h"
+#include "../site/Site.h"
+
+// load the keep-out model and build the map
+void Limits::keepOutInit() {
+  nvKeyKeepOut = nv().kv().computeKey("LIMIT_KEEP_OUT");
+  if (!nv().kv().getOrInit(nvKeyKeepOut, keepOutSettings)) { DLF("WRN: Nv, init failed for LIMIT_KEEP_OUT"); }
+
+  for (int n = 0; n < KEEP_OUT_PARAMETERS; n++) keepOutPut(n, constrain(getKeepOut(n), 0, 5000));
+
+  keepOutBuild();
+}
+
+// set keep-out model parameter n (0 to 9) in mm, the keep-out map is rebuilt
+CommandError Limits::setKeepOut(int n, int mm) {
+  if (n < 0 || n >= KEEP_OUT_PARAMETERS) return CE_PARAM_RANGE;
+  if (mm < 0 || mm > 5000) return CE_PARAM_RANGE;
+
+  keepOutPut(n, mm);
+  nv().kv().put(nvKeyKeepOut, keepOutSettings);
+  keepOutBuild();
+  return CE_NONE;
+}
+
+// get keep-out model parameter n (0 to 9) in mm
+int Limits::getKeepOut(int n) {
+  if (n < 0 || n >= KEEP_OUT_PARAMETERS) return 0;
+
+  // the settings are packed so copy rather than read an int16_t that may not be aligned
+  int16_t value;
+  memcpy(&value, (uint8_t*)&keepOutSettings + n*sizeof(int16_t), sizeof(int16_t));
+  return value;
+}
+
+// set keep-out model parameter n in mm without checks
+void Limits::keepOutPut(int n, int16_t value) {
+  memcpy((uint8_t*)&keepOutSettings + n*sizeof(int16_t), &value, sizeof(int16_t));
+}
+
+// true if the instrument coordinates (in radians) fall in a keep-out zone
+bool Limits::isKeepOut(double a1, double a2) {
+  float d1 = radToDegF(a1) + 180.0F;
+  float d2 = radToDegF(a2) + 180.0F;
+  d1 = fmodf(d1, 360.0F); if (d1 < 0.0F) d1 += 360.0F;
+  d2 = fmodf(d2, 360.0F); if (d2 < 0.0F) d2 += 360.0F;
+
+  int i = (int)(d1/KEEP_OUT_CELL_DEG); if (i >= KEEP_OUT_CELLS) i = KEEP_OUT_CELLS - 1;
+  int j = (int)(d2/KEEP_OUT_CELL_DEG); if (j >= KEEP_OUT_CELLS) j = KEEP_OUT_CELLS - 1;
+
+  int bit = i*KEEP_OUT_CELLS + j;
+  return keepOutMap[bit >> 3] & (1 << (bit & 7));
+}
+
+// true if the straight path between instrument coordinates (in radians) crosses a keep-out zone, a path
+// starting inside a zone must leave it within KEEP_OUT_EXIT_CELLS cells and not enter one again
+bool Limits::isKeepOutPath(double a1, double a2, double b1, double b2) {
+  double span = fmax(fabs(b1 - a1), fabs(b2 - a2));
+  int steps = (int)(span/degToRad(KEEP_OUT_CELL_DEG)) + 1;
+
+  bool leaving = true;
+  for (int k = 0; k <= steps; k++) {
+    double f = (double)k/steps;
+    if (isKeepOut(a1 + (b1 - a1)*f, a2 + (b2 - a2)*f)) {
+      if (!leaving || k > KEEP_OUT_EXIT_CELLS) return true;
+    } else leaving = false;
+  }
+  return false;
+}
+
+// true if moving instrument axis (1 or 2) in direction (1 or -1) from the current position leaves
+// the keep-out zone within KEEP_OUT_EXIT_CELLS cells
+bool Limits::isKeepOutExit(int axis, int direction) {
+  double a1 = axis1.getInstrumentCoordinate();
+  double a2 = axis2.getInstrumentCoordinate();
+  double step = direction*degToRad(KEEP_OUT_CELL_DEG);
+
+  for (int k = 1; k <= KEEP_OUT_EXIT_CELLS; k++) {
+    if (axis == 1) a1 += step; else a2 += step;
+    if (!isKeepOut(a1, a2)) return true;
+  }
+  return false;
+}
+
+// true if tracking from the current position leaves the keep-out zone within KEEP_OUT_EXIT_CELLS cells
+bool Limits::isKeepOutTrackingExit() {
+  Coordinate position = mount.getMountPosition(CR_MOUNT);
+  double step = degToRad(KEEP_OUT_CELL_DEG);
+  if (mount.trackingRate < 0.0F) step = -step;
+
+  for (int k = 1; k <= KEEP_OUT_EXIT_CELLS; k++) {
+    position.h += step;
+    double a1, a2;
+    transform.mountToInstrument(&position, &a1, &a2);
+    if (!isKeepOut(a1, a2)) return true;
+  }
+  return false;
+}
+
+// rebuild the keep-out map from the model for the current site latitude
+void Limits::keepOutBuild() {
+  memset(keepOutMap, 0, sizeof(keepOutMap));
+
+  if (!transform.isEquatorial()) return;
+  if (keepOutSettings.pierRadius == 0 && keepOutSettings.tripodRadius == 0) return;
+
+  // each cell is tested at its center so grow the clearance by the most a cell's corner can move the OTA or counterweights
+  float lever = fmaxf(fmaxf(keepOutSettings.otaFront, keepOutSettings.otaRear), keepOutSettings.cwLength) + keepOutSettings.otaOffset;
+  float margin = lever*degToRadF(KEEP_OUT_CELL_DEG*0.7072F);
+
+  int count = 0;
+  for (int i = 0; i < KEEP_OUT_CELLS; i++) {
+    double a1 = degToRad(-180.0 + (i + 0.5)*KEEP_OUT_CELL_DEG);
+    for (int j = 0; j < KEEP_OUT_CELLS; j++) {
+      double a2 = degToRad(-180.0 + (j + 0.5)*KEEP_OUT_CELL_DEG);
+      Coordinate position = transform.instrumentToMount(a1, a2);
+      if (keepOutCollision(position.h, position.d, position.pierSide, margin)) {
+        int bit = i*KEEP_OUT_CELLS + j;
+        keepOutMap[bit >> 3] |= (1 << (bit & 7));
+        count++;
+      }
+    }
+    Y;
+  }
+
+  VF("MSG: Limits, keep-out map built with "); V(count); VF(" of "); V(KEEP_OUT_CELLS*KEEP_OUT_CELLS); VLF(" cells blocked");
+}
+
+// true if the OTA or counterweights at this equatorial position and pier side touch the pier or tripod
+bool Limits::keepOutCollision(double h, double d, PierSide pierSide, float margin) {
+  // pointing and Dec axis (toward the OTA) directions with X toward the meridian, Y east, and Z toward the NCP
+  float px = cos(d)*cos(h);
+  float py = -cos(d)*sin(h);
+  float pz = sin(d);
+  float sign = (pierSide == PIER_SIDE_WEST) ? -1.0F : 1.0F;
+  float dx = sign*sin(h);
+  float dy = sign*cos(h);
+
+  // rotate into horizon coordinates with x east, y north, and z up
+  float sinLat = sin(site.location.latitude);
+  float cosLat = cos(site.location.latitude);
+  float ox = py;
+  float oy = -px*sinLat + pz*cosLat;
+  float oz = px*cosLat + pz*sinLat;
+  float wx = dy;
+  float wy = -dx*sinLat;
+  float wz = dx*cosLat;
+
+  // OTA, offset along the Dec axis from the RA axis
+  if (keepOutSettings.otaFront > 0 || keepOutSettings.otaRear > 0) {
+    float cx = wx*keepOutSettings.otaOffset;
+    float cy = wy*keepOutSettings.otaOffset;
+    float cz = wz*keepOutSettings.otaOffset;
+    float length = keepOutSettings.otaFront + keepOutSettings.otaRear;
+    for (int k = 0; k <= 8; k++) {
+      float t = -keepOutSettings.otaRear + length*k/8.0F;
+      if (keepOutInside(cx + ox*t, cy + oy*t, cz + oz*t, keepOutSettings.otaRadius + margin)) return true;
+    }
+  }
+
+  // counterweight shaft, opposite the OTA along the Dec axis
+  if (keepOutSettings.cwLength > 0) {
+    for (int k = 1; k <= 4; k++) {
+      float t = -keepOutSettings.cwLength*k/4.0F;
+      if (keepOutInside(wx*t, wy*t, wz*t, keepOutSettings.cwRadius + margin)) return true;
+    }
+  }
+
+  return false;
+}
+
+// true if the point (in mm, x east, y north, z up) is inside the pier or tripod grown by clearance
+bool Limits::keepOutInside(float x, float y, float z, float clearance) {
+  float r = sqrtf(x*x + y*y);
+  if (keepOutSettings.pierRadius > 0 && z < -keepOutSettings.pierTop + clearance && r < keepOutSettings.pierRadius + clearance) return true;
+  if (keepOutSettings.tripodRadius > 0 && z < -keepOutSettings.tripodTop + clearance && r < keepOutSettings.tripodRadius + clearance) return true;
+  return false;
+}
+
+#endif
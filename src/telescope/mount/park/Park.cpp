@@ -139,8 +139,7 @@ CommandError Park::request() {
 
     if (e != CE_NONE) {
       mount.tracking(wasTracking);
-      axis1.setBacklash(mount.settings.backlash.axis1);
-      axis2.setBacklash(mount.settings.backlash.axis2);
+      mount.applyBacklash();
 
       state = priorParkState;
       settings.state = state;
@@ -159,8 +158,7 @@ void Park::requestAborted() {
   nv().kv().put(nvKey, settings);
   
   // restore backlash settings
-  axis1.setBacklash(mount.settings.backlash.axis1);
-  axis2.setBacklash(mount.settings.backlash.axis2);
+  mount.applyBacklash();
   
   mount.tracking(wasTracking);
 }
@@ -173,8 +171,7 @@ void Park::requestDone() {
       VLF("MSG: Mount, park sense state indicates success.");
     } else {
       DLF("WRN: Mount, park sense state failed!");
-      axis1.setBacklash(mount.settings.backlash.axis1);
-      axis2.setBacklash(mount.settings.backlash.axis2);
+      mount.applyBacklash();
       state = PS_PARK_FAILED;
       settings.state = state;
       nv().kv().put(nvKey, settings);
@@ -284,8 +281,7 @@ CommandError Park::restore(bool withTrackingOn) {
     VF("MSG: Mount, unpark axis2 motor position "); VL(axis2.getMotorPositionSteps());
 
     // restore backlash settings
-    axis1.setBacklash(mount.settings.backlash.axis1);
-    axis2.setBacklash(mount.settings.backlash.axis2);
+    mount.applyBacklash();
   }
   
   limits.enabled(true);
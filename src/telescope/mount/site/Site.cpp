@@ -231,6 +231,11 @@ void Site::updateLocation() {
   // same date and time, just calculates the sidereal time again
   ut1.hour = getTime();
   setSiderealTime(ut1);
+
+  #if LIMIT_KEEP_OUT == ON
+    // the keep-out map depends on the latitude
+    limits.keepOutBuild();
+  #endif
 }
 
 // update the initError status and restore the park position if necessary
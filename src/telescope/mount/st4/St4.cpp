@@ -48,13 +48,141 @@
     st4.pollSerial();
   }
 
+  #if ST4_EDGE_CAPTURE == ON
+    IRAM_ATTR void st4EdgeAxis1Wrapper() { st4.edge(0); }
+    IRAM_ATTR void st4EdgeAxis2Wrapper() { st4.edge(1); }
+  #endif
+
   void St4::init() {
+    #if ST4_EDGE_CAPTURE == ON
+      for (int i = 0; i < 2; i++) { edgeAxis[i].isrAction = GA_BREAK; edgeAxis[i].start.action = GA_BREAK; }
+
+      int pinAxis1Rev = digitalPinToInterrupt(ST4_RA_E_PIN);
+      int pinAxis1Fwd = digitalPinToInterrupt(ST4_RA_W_PIN);
+      int pinAxis2Fwd = digitalPinToInterrupt(ST4_DEC_N_PIN);
+      int pinAxis2Rev = digitalPinToInterrupt(ST4_DEC_S_PIN);
+      if (pinAxis1Rev >= 0 && pinAxis1Fwd >= 0 && pinAxis2Fwd >= 0 && pinAxis2Rev >= 0) {
+        VLF("MSG: Mount, ST4 edge capture using pin interrupts");
+        attachInterrupt(pinAxis1Rev, st4EdgeAxis1Wrapper, CHANGE);
+        attachInterrupt(pinAxis1Fwd, st4EdgeAxis1Wrapper, CHANGE);
+        attachInterrupt(pinAxis2Fwd, st4EdgeAxis2Wrapper, CHANGE);
+        attachInterrupt(pinAxis2Rev, st4EdgeAxis2Wrapper, CHANGE);
+        edgeCapture = true;
+      } else { DLF("WRN: Mount, ST4 edge capture pin interrupts unavailable falling back to polling"); }
+    #endif
+
     long rate = round(1000.0F/HAL_FRACTIONAL_SEC);
     VF("MSG: Mount, ST4 start monitor task (rate "); V(rate); VF("ms priority 2)... ");
     if (tasks.add(rate, 0, true, 2, st4Wrapper, "St4Mntr")) { VLF("success"); } else { VLF("FAILED!"); }
   }
 
+  #if ST4_EDGE_CAPTURE == ON
+    IRAM_ATTR void St4::edge(uint8_t axis) {
+      uint32_t ticks = HAL_FAST_TICKS();
+
+      bool fwd, rev;
+      if (axis == 0) {
+        fwd = digitalRead(ST4_RA_W_PIN) == LOW;
+        rev = digitalRead(ST4_RA_E_PIN) == LOW;
+      } else {
+        fwd = digitalRead(ST4_DEC_N_PIN) == LOW;
+        rev = digitalRead(ST4_DEC_S_PIN) == LOW;
+      }
+
+      uint8_t action = GA_BREAK;
+      if (fwd && !rev) action = GA_FORWARD;
+      if (rev && !fwd) action = GA_REVERSE;
+
+      // edges that don't change the action are dropped here, bounce is settled in pollEdges()
+      St4EdgeAxis *e = &edgeAxis[axis];
+      if (action == e->isrAction) return;
+      e->isrAction = action;
+
+      // if the buffer is full replace the most recent edge so the final state is never lost
+      uint8_t index = e->head;
+      uint8_t next = (index + 1) & (ST4_EDGE_BUFFER_SIZE - 1);
+      if (next == e->tail) { index = (index - 1) & (ST4_EDGE_BUFFER_SIZE - 1); next = e->head; }
+
+      e->buffer[index].ticks = ticks;
+      e->buffer[index].ms = millis();
+      e->buffer[index].action = action;
+      e->head = next;
+    }
+
+    void St4::pollEdges(uint8_t axis) {
+      St4EdgeAxis *e = &edgeAxis[axis];
+
+      // contact bounce is a burst of edges, the first starts a pending change and the rest only update
+      // the action it settles to, so the change keeps the time of the first edge
+      while (e->tail != e->head) {
+        noInterrupts();
+        St4Edge edge = e->buffer[e->tail];
+        e->tail = (e->tail + 1) & (ST4_EDGE_BUFFER_SIZE - 1);
+        interrupts();
+
+        if (!e->pending) {
+          if (edge.action == e->start.action) continue;
+          e->change = edge;
+          e->pending = true;
+        } else e->change.action = edge.action;
+        e->lastEdgeMs = edge.ms;
+      }
+
+      // the same hysteresis as the polled buttons
+      if (!e->pending || (long)(millis() - e->lastEdgeMs) < debounceMs) return;
+      e->pending = false;
+      St4Edge edge = e->change;
+      if (edge.action == e->start.action) return;
+
+      GuideRateSelect rateSelect = guide.settings.axis1RateSelect;
+      if (axis == 1) rateSelect = guide.settings.axis2RateSelect;
+      if (GUIDE_SEPARATE_PULSE_RATE == ON) rateSelect = guide.settings.pulseRateSelect;
+
+      if (edge.action != GA_BREAK) {
+        if (!mount.isEnabled()) return;
+        if (axis == 0) guide.startAxis1((GuideAction)edge.action, rateSelect, GUIDE_TIME_LIMIT*1000);
+        else guide.startAxis2((GuideAction)edge.action, rateSelect, GUIDE_TIME_LIMIT*1000);
+        e->start = edge;
+        e->startMs = millis();
+        e->startTicks = HAL_FAST_TICKS();
+      } else {
+        // the pulse length comes from the edge timestamps, the guide has run for the pulse plus the
+        // latency in stopping it less the latency in starting it, the difference is made up here
+        long overrunMs;
+        if (edge.ms - e->start.ms < 1000) {
+          long ticksPerMs = HAL_TICKS_PER_SECOND()/1000UL;
+          long overrunTicks = (long)((HAL_FAST_TICKS() - e->startTicks) - (edge.ticks - e->start.ticks));
+          overrunMs = (overrunTicks + (overrunTicks < 0 ? -ticksPerMs/2 : ticksPerMs/2))/ticksPerMs;
+        } else overrunMs = (long)(millis() - e->startMs) - (long)(edge.ms - e->start.ms);
+
+        GuideAction action = (GuideAction)e->start.action;
+        if (overrunMs < 0) {
+          // stopped early, run on for the rest of the pulse
+          if (axis == 0) guide.startAxis1(action, rateSelect, -overrunMs);
+          else guide.startAxis2(action, rateSelect, -overrunMs);
+        } else
+        if (overrunMs > 0 && guide.activePulseGuide()) {
+          // stopped late, a pulse guide moves by the same rate either way so back out the overrun
+          action = action == GA_FORWARD ? GA_REVERSE : GA_FORWARD;
+          if (axis == 0) guide.startAxis1(action, rateSelect, overrunMs);
+          else guide.startAxis2(action, rateSelect, overrunMs);
+        } else {
+          if (axis == 0) guide.stopAxis1(); else guide.stopAxis2();
+        }
+        e->start.action = GA_BREAK;
+      }
+    }
+  #endif
+
   void St4::poll() {
+    #if ST4_EDGE_CAPTURE == ON
+      if (edgeCapture) {
+        pollEdges(0);
+        pollEdges(1);
+        return;
+      }
+    #endif
+
     static bool shcActive = false;
 
     st4Axis1Rev.poll();
@@ -6,6 +6,30 @@
 
 #ifdef MOUNT_PRESENT
 
+#if ST4_EDGE_CAPTURE == ON
+  // must be a power of two
+  #define ST4_EDGE_BUFFER_SIZE 8
+
+  typedef struct St4Edge {
+    uint32_t ticks;   // HAL_FAST_TICKS() when the edge occurred
+    uint32_t ms;      // millis() when the edge occurred, for periods longer than the ticks wrap
+    uint8_t action;   // GuideAction the pin states now call for
+  } St4Edge;
+
+  typedef struct St4EdgeAxis {
+    St4Edge buffer[ST4_EDGE_BUFFER_SIZE];
+    volatile uint8_t head = 0;
+    volatile uint8_t tail = 0;
+    uint8_t isrAction = 0;      // last action recorded by the interrupt
+    St4Edge start = {0, 0, 0};  // edge that started the guide in progress
+    unsigned long startMs = 0;  // millis() when that guide was started
+    uint32_t startTicks = 0;    // HAL_FAST_TICKS() when that guide was started
+    St4Edge change = {0, 0, 0}; // first edge of a change that is still settling, with the latest action
+    bool pending = false;
+    uint32_t lastEdgeMs = 0;
+  } St4EdgeAxis;
+#endif
+
 class St4 {
   public:
     void init();
@@ -18,7 +42,20 @@ class St4 {
     void pollSerial();
     #endif
 
+    #if ST4_EDGE_CAPTURE == ON
+    // record an edge on one of the ST4 pins, called from the pin interrupts
+    void edge(uint8_t axis);
+    #endif
+
   private:
+    #if ST4_EDGE_CAPTURE == ON
+    // start or stop guiding for the edges captured on this axis
+    void pollEdges(uint8_t axis);
+
+    bool edgeCapture = false;
+    St4EdgeAxis edgeAxis[2];
+    #endif
+
     uint8_t handleSerialST4 = 0;
 };
 
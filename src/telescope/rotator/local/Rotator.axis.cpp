@@ -42,6 +42,8 @@ namespace {
 
   #if AXIS3_SERVO_FLTR == KALMAN
     KalmanFilter filterAxis3(AXIS3_SERVO_FLTR_MEAS_U, AXIS3_SERVO_FLTR_VARIANCE);
+  #elif AXIS3_SERVO_FLTR == LEARNING
+    LearningFilter filterAxis3(3, AXIS3_SERVO_FLTR_WSIZE, AXIS3_SERVO_FLTR_PERIOD1, AXIS3_SERVO_FLTR_PERIOD2, AXIS3_SERVO_FLTR_PERIOD3);
   #elif AXIS3_SERVO_FLTR == ROLLING
     RollingFilter filterAxis3(AXIS3_SERVO_FLTR_WSIZE);
   #elif AXIS3_SERVO_FLTR == OFF